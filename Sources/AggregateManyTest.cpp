@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(AggregateMany, Contiguous)
+{
+	std::vector<int> src(5000);
+
+	for (size_t i = 0; i < src.size(); ++i)
+	{
+		src[i] = static_cast<int>((i * 7919) % 5003) - 2500;
+	}
+
+	auto stats = CppLinq::From(src).AggregateMany<CppLinq::AggregateSum, CppLinq::AggregateMin, CppLinq::AggregateMax, CppLinq::AggregateCount, CppLinq::AggregateAverage>();
+
+	EXPECT_EQ(CppLinq::From(src).Sum(), std::get<0>(stats));
+	EXPECT_EQ(CppLinq::From(src).Min(), std::get<1>(stats));
+	EXPECT_EQ(CppLinq::From(src).Max(), std::get<2>(stats));
+	EXPECT_EQ(5000u, std::get<3>(stats));
+	EXPECT_EQ(std::get<0>(stats) / 5000, std::get<4>(stats));
+}
+
+TEST(AggregateMany, Pipeline)
+{
+	std::list<double> src = { 2.5, -1.0, 4.0, 8.5, 3.0 };
+	int calls = 0;
+
+	auto stats = CppLinq::From(src).Select([&](double a) { ++calls; return a * 2; })
+		.AggregateMany<CppLinq::AggregateCount, CppLinq::AggregateAverage, CppLinq::AggregateMax>();
+
+	EXPECT_EQ(5, calls);
+	EXPECT_EQ(5u, std::get<0>(stats));
+	EXPECT_DOUBLE_EQ(6.8, std::get<1>(stats));
+	EXPECT_DOUBLE_EQ(17.0, std::get<2>(stats));
+}
+
+TEST(AggregateMany, Empty)
+{
+	std::vector<int> src;
+
+	auto stats = CppLinq::From(src).AggregateMany<CppLinq::AggregateCount, CppLinq::AggregateSum, CppLinq::AggregateAverage>();
+
+	EXPECT_EQ(std::make_tuple(std::size_t(0), 0, 0), stats);
+	EXPECT_THROW(CppLinq::From(src).AggregateMany<CppLinq::AggregateMin>(), CppLinq::EnumeratorEndException);
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(AnyEnumerable, StoreDifferentQueries)
+{
+	std::vector<int> src = { 1, 2, 3, 4, 5, 6 };
+	int ans1[] = { 2, 4, 6 };
+	int ans2[] = { 10, 20, 30, 40, 50, 60 };
+	int ans3[] = { 5, 4 };
+
+	std::vector<CppLinq::LinqObject<CppLinq::AnyEnumerable<int>>> queries;
+	queries.push_back(CppLinq::From(src).Where([](int a) { return a % 2 == 0; }).AsAnyEnumerable());
+	queries.push_back(CppLinq::From(src).Select([](int a) { return a * 10; }).AsAnyEnumerable());
+	queries.push_back(CppLinq::From(src).Reverse().Skip(1).Take(2).Where([](int a) { return a > 0; }).AsAnyEnumerable());
+
+	IsEqualArray(queries[0], ans1);
+	IsEqualArray(queries[1], ans2);
+	IsEqualArray(queries[2], ans3);
+	EXPECT_EQ(12, queries[2].Skip(0).Sum() + queries[0].Count());
+}
+
+TEST(AnyEnumerable, NextBatch)
+{
+	auto rng = CppLinq::Repeat(7, 100).Select([](int a) { return a + 1; });
+	CppLinq::AnyEnumerable<int> dst = rng.AsAnyEnumerable().m_enumerator;
+
+	std::vector<int> batch(64);
+	EXPECT_EQ(8, dst.NextObject());
+	EXPECT_EQ(64u, dst.NextBatch(CppLinq::Span<int>(batch.data(), batch.size())));
+	EXPECT_EQ(35u, dst.NextBatch(CppLinq::Span<int>(batch.data(), batch.size())));
+	EXPECT_EQ(8, batch[34]);
+	EXPECT_EQ(0u, dst.NextBatch(CppLinq::Span<int>(batch.data(), batch.size())));
+	EXPECT_THROW(dst.NextObject(), CppLinq::EnumeratorEndException);
+}
+
+TEST(AnyEnumerable, PullsOnlyWhatIsAsked)
+{
+	std::vector<int> src = { 1, 2, 3, 4, 5, 6 };
+	int ans[] = { 1, 2 };
+	int calls = 0;
+
+	auto rng = CppLinq::From(src).Select([&](int a) { calls++; return a; }).AsAnyEnumerable();
+
+	IsEqualArray(rng.Take(2), ans);
+	EXPECT_EQ(2, calls);
+
+	calls = 0;
+	EXPECT_EQ(1, rng.First());
+	EXPECT_EQ(1, calls);
+}
+
+TEST(AnyEnumerable, NotDefaultConstructible)
+{
+	struct Item
+	{
+		explicit Item(int value) : value(value) { }
+
+		int value;
+	};
+
+	std::vector<Item> src = { Item(1), Item(2), Item(3) };
+
+	auto rng = CppLinq::From(src).AsAnyEnumerable();
+
+	EXPECT_EQ(3u, rng.Count());
+	EXPECT_EQ(6, rng.Sum([](const Item& item) { return item.value; }));
+	EXPECT_EQ(2, rng.Skip(1).First().value);
+}
+
+TEST(AnyEnumerable, MovedFrom)
+{
+	std::vector<int> src = { 1, 2, 3 };
+
+	CppLinq::AnyEnumerable<int> rng = CppLinq::From(src).AsAnyEnumerable().m_enumerator;
+	CppLinq::AnyEnumerable<int> moved = std::move(rng);
+	CppLinq::AnyEnumerable<int> copy = rng;
+
+	EXPECT_EQ(1, moved.NextObject());
+	EXPECT_EQ(0u, copy.Size());
+	EXPECT_FALSE(copy.TryNextObject().has_value());
+	EXPECT_THROW(copy.NextObject(), CppLinq::EnumeratorEndException);
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <sstream>
+#include <string>
+
+namespace
+{
+	CppLinq::Task<void> ReadLines(std::istream& stream, CppLinq::AsyncChannel<std::string>& channel, std::size_t& maxQueued)
+	{
+		for (std::string line; std::getline(stream, line);)
+		{
+			co_await channel.Send(line);
+			maxQueued = std::max(maxQueued, channel.Size());
+		}
+
+		channel.Close();
+	}
+
+	CppLinq::Task<void> Numbers(CppLinq::AsyncChannel<int>& channel, int& sent)
+	{
+		for (int i = 0; co_await channel.Send(i); ++i)
+		{
+			++sent;
+		}
+	}
+}
+
+TEST(Async, Backpressure)
+{
+	std::istringstream stream("a\nbb\nccc\ndddd\neeeee\nffffff\ng\n");
+	std::size_t maxQueued = 0;
+
+	CppLinq::EventLoop loop;
+	CppLinq::AsyncChannel<std::string> channel(loop, 2);
+	loop.Spawn(ReadLines(stream, channel, maxQueued));
+
+	auto query = CppLinq::FromAsync(channel)
+		.Select([](const std::string& line) { return line.size(); })
+		.Where([](std::size_t size) { return size % 2 == 1; });
+
+	EXPECT_EQ((std::vector<std::size_t>{ 1, 3, 5, 1 }), loop.Run(query.ToVector()));
+	EXPECT_LE(maxQueued, 2u);
+}
+
+TEST(Async, TakeStopsProducer)
+{
+	int sent = 0;
+
+	CppLinq::EventLoop loop;
+	CppLinq::AsyncChannel<int> channel(loop, 4);
+	loop.Spawn(Numbers(channel, sent));
+
+	EXPECT_EQ(10, loop.Run(CppLinq::FromAsync(channel).Take(5).Sum()));
+	EXPECT_LE(sent, 10);
+
+	channel.Close();
+	loop.Run();
+}
+
+TEST(Async, SynchronousSource)
+{
+	CppLinq::EventLoop loop;
+	auto query = CppLinq::FromAsync(CppLinq::Range(1, 11, 1)).Where([](int a) { return a % 2 == 0; });
+
+	EXPECT_EQ(5u, loop.Run(query.Count()));
+	EXPECT_EQ(30, loop.Run(query.Sum()));
+
+	int sum = 0;
+	loop.Run(query.Foreach([&](int a) { sum += a; }));
+	EXPECT_EQ(30, sum);
+}
+
+TEST(Async, Exception)
+{
+	CppLinq::EventLoop loop;
+	auto query = CppLinq::FromAsync(CppLinq::Range(0, 3, 1)).Select([](int a) { return (a == 2) ? throw std::runtime_error("read error") : a; });
+
+	EXPECT_THROW(loop.Run(query.ToVector()), std::runtime_error);
+}
+#endif
\ No newline at end of file
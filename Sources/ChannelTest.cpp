@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(Channel, SingleProducer)
+{
+	CppLinq::Channel<int> channel(4);
+
+	std::thread producer([&]
+	{
+		for (int i = 1; i <= 1000; ++i)
+		{
+			channel.Send(i);
+		}
+
+		channel.Close();
+	});
+
+	std::vector<int> dst = CppLinq::From(channel).Where([](int a) { return a % 100 == 0; }).ToVector();
+	producer.join();
+
+	EXPECT_EQ((std::vector<int>{ 100, 200, 300, 400, 500, 600, 700, 800, 900, 1000 }), dst);
+	EXPECT_EQ(0, CppLinq::From(channel).Count());
+}
+
+TEST(Channel, MultipleProducers)
+{
+	CppLinq::Channel<long long> channel(256);
+	std::vector<std::thread> producers;
+
+	for (int p = 0; p < 4; ++p)
+	{
+		producers.emplace_back([&channel, p]
+		{
+			for (long long i = 0; i < 100000; ++i)
+			{
+				channel.Send(i * 4 + p);
+			}
+		});
+	}
+
+	std::thread closer([&]
+	{
+		for (std::thread& producer : producers)
+		{
+			producer.join();
+		}
+
+		channel.Close();
+	});
+
+	long long sum = CppLinq::From(channel).Sum();
+	closer.join();
+
+	EXPECT_EQ(399999LL * 400000LL / 2, sum);
+}
+
+TEST(Channel, Bounded)
+{
+	CppLinq::Channel<int> channel(3);
+
+	EXPECT_EQ(4u, channel.Capacity());
+	EXPECT_TRUE(channel.TrySend(1));
+	EXPECT_TRUE(channel.TrySend(2));
+	EXPECT_TRUE(channel.TrySend(3));
+	EXPECT_TRUE(channel.TrySend(4));
+	EXPECT_FALSE(channel.TrySend(5));
+	EXPECT_EQ(1, channel.Receive());
+	EXPECT_TRUE(channel.TrySend(5));
+
+	channel.Close();
+
+	int ans[] = { 2, 3, 4, 5 };
+
+	EXPECT_FALSE(channel.Send(6));
+	IsEqualArray(CppLinq::From(channel), ans);
+}
\ No newline at end of file
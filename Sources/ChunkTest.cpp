@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(Chunk, ContiguousSource)
+{
+	std::vector<int> src = { 1, 2, 3, 4, 5, 6, 7 };
+	int ans[] = { 3, 7, 11, 7 };
+
+	auto rng = CppLinq::From(src).Chunk(2);
+	auto dst = rng.Select([](CppLinq::Span<const int> a) { return CppLinq::From(a).Sum(); });
+
+	EXPECT_EQ(4u, rng.m_enumerator.Size());
+	EXPECT_EQ(src.data() + 2, rng.ElementAt(1).Data());
+	IsEqualArray(dst, ans);
+}
+
+TEST(Chunk, BufferedSource)
+{
+	std::list<int> src = { 1, 2, 3, 4, 5, 6, 7 };
+	size_t ans[] = { 3, 3, 1 };
+
+	auto dst = CppLinq::From(src).Where([](int a) { return a > 0; }).Chunk(3).Select([](CppLinq::Span<const int> a) { return a.Size(); });
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(3, CppLinq::From(src).Chunk(3).Count());
+}
+
+TEST(Chunk, ReusedBuffer)
+{
+	std::list<int> src = { 1, 2, 3, 4, 5 };
+	std::vector<std::vector<int>> ans = { { 1, 2 }, { 3, 4 }, { 5 } };
+
+	auto rng = CppLinq::From(src).Chunk(2);
+	auto first = rng.NextObject();
+	const int* data = first.Data();
+
+	EXPECT_EQ(2u, first.Size());
+	EXPECT_EQ(2, first[1]);
+	EXPECT_EQ(data, rng.NextObject().Data());
+
+	auto dst = CppLinq::From(src).Chunk(2).Select([](CppLinq::Span<const int> a) { return std::vector<int>(a.begin(), a.end()); });
+
+	EXPECT_EQ(ans, dst.ToVector());
+}
+
+TEST(Chunk, ForeachBatch)
+{
+	std::list<int> src1 = { 1, 2, 3, 4, 5 };
+	std::vector<int> src2 = { 1, 2, 3, 4, 5 };
+
+	std::vector<std::vector<int>> ans = { { 1, 2 }, { 3, 4 }, { 5 } };
+	std::vector<std::vector<int>> dst1;
+	std::vector<std::vector<int>> dst2;
+
+	CppLinq::From(src1).ForeachBatch(2, [&](CppLinq::Span<const int> batch) { dst1.emplace_back(batch.begin(), batch.end()); });
+	CppLinq::From(src2).ForeachBatch(2, [&](CppLinq::Span<const int> batch) { dst2.emplace_back(batch.begin(), batch.end()); });
+
+	EXPECT_EQ(ans, dst1);
+	EXPECT_EQ(ans, dst2);
+}
\ No newline at end of file
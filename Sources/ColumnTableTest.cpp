@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+struct Trade
+{
+	int id;
+	double price;
+	long long volume;
+	std::string venue;
+	int desk;
+};
+
+using TradeTable = CppLinq::ColumnTable<Trade, &Trade::id, &Trade::price, &Trade::volume, &Trade::venue, &Trade::desk>;
+
+static TradeTable MakeTrades()
+{
+	TradeTable table;
+	table.Reserve(5);
+
+	table.Add({ 1, 10.5, 100, "A", 7 });
+	table.Add({ 2, 99.0, 5, "B", 7 });
+	table.Add({ 3, 12.0, 700, "A", 8 });
+	table.Add({ 4, 101.5, 40, "C", 9 });
+	table.Add({ 5, 11.0, 900, "B", 8 });
+
+	return table;
+}
+
+TEST(ColumnTable, SelectColumn)
+{
+	TradeTable table = MakeTrades();
+	long long ans[] = { 100, 5, 700, 40, 900 };
+
+	auto dst = CppLinq::From(table).Select(&Trade::volume);
+
+	IsEqualArray(dst, ans);
+	EXPECT_TRUE(CppLinq::IsContiguousEnumerator<decltype(dst.m_enumerator)>::value);
+	EXPECT_EQ(table.Column(&Trade::volume).data(), dst.m_enumerator.Data());
+	EXPECT_EQ(1745LL, dst.Sum());
+	EXPECT_EQ(5u, CppLinq::From(table).Count());
+}
+
+TEST(ColumnTable, WhereSelect)
+{
+	TradeTable table = MakeTrades();
+	int ans[] = { 3, 5 };
+
+	auto dst = CppLinq::From(table)
+		.Where(&Trade::price, [](double price) { return price < 50.0; })
+		.Where(&Trade::volume, [](long long volume) { return volume > 500; })
+		.Select(&Trade::id);
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(2u, dst.Count());
+	EXPECT_EQ(2u, dst.m_enumerator.FilterCount());
+	EXPECT_EQ("Source: column table column", dst.Explain().name);
+	EXPECT_EQ("Source: column table", CppLinq::From(table).Where(&Trade::id, [](int id) { return id > 1; }).Explain().name);
+}
+
+TEST(ColumnTable, LateMaterialization)
+{
+	TradeTable table = MakeTrades();
+
+	auto filtered = CppLinq::From(table).Where(&Trade::price, [](double price) { return price > 50.0; });
+	std::vector<Trade> rows = filtered.ToVector();
+
+	EXPECT_EQ(2u, filtered.Count());
+	ASSERT_EQ(2u, rows.size());
+	EXPECT_EQ(2, rows[0].id);
+	EXPECT_EQ(99.0, rows[0].price);
+	EXPECT_EQ(5LL, rows[0].volume);
+	EXPECT_EQ("B", rows[0].venue);
+	EXPECT_EQ(7, rows[0].desk);
+	EXPECT_EQ(4, rows[1].id);
+	EXPECT_EQ("C", rows[1].venue);
+	EXPECT_EQ(9, rows[1].desk);
+
+	std::vector<Trade> src = { { 1, 10.5, 100, "A", 7 }, { 2, 99.0, 5, "B", 7 } };
+	int ans[] = { 2 };
+
+	IsEqualArray(CppLinq::From(src).Where(&Trade::price, [](double price) { return price > 50.0; }).Select(&Trade::id), ans);
+}
+
+TEST(ColumnTable, FiltersRunPerTerminal)
+{
+	TradeTable table = MakeTrades();
+	int calls = 0;
+	double limit = 50.0;
+
+	auto filtered = CppLinq::From(table).Where(&Trade::price, [&](double price) { calls++; return price < limit; });
+	auto volumes = filtered.Select(&Trade::volume);
+
+	EXPECT_EQ(3u, filtered.ToVector().size());
+	EXPECT_EQ(5, calls);
+	EXPECT_EQ(3u, filtered.Count());
+	EXPECT_EQ(10, calls);
+	EXPECT_EQ(1700LL, volumes.Sum());
+	EXPECT_EQ(15, calls);
+	EXPECT_EQ(3u, volumes.Count());
+	EXPECT_EQ(20, calls);
+
+	table.Add({ 6, 1.0, 1, "D", 9 });
+	limit = 11.5;
+
+	EXPECT_EQ(3u, filtered.Count());
+	EXPECT_EQ(26, calls);
+	EXPECT_EQ(1001LL, volumes.Sum());
+}
+
+TEST(ColumnTable, ColumnsOnly)
+{
+	TradeTable table = MakeTrades();
+
+	static_assert(TradeTable::HasColumnOf<std::string>(), "venue is a column");
+	static_assert(!TradeTable::HasColumnOf<float>(), "no column is a float");
+
+	EXPECT_EQ(5u, table.Size());
+	EXPECT_EQ("C", table.RowAt(3).venue);
+	EXPECT_EQ(8, table.RowAt(4).desk);
+	EXPECT_EQ(7, CppLinq::From(table).Select(&Trade::desk).First());
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(ConcatAll, DifferentSources)
+{
+	int src1[] = { 1, 2 };
+	std::list<int> src2 = { 3 };
+	std::vector<int> src3 = { 4, 5, 6 };
+
+	int ans[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+	auto rng1 = CppLinq::From(src1);
+	auto rng2 = CppLinq::From(src2);
+	auto rng3 = CppLinq::From(src3).Where([](int a) { return a > 3; });
+	auto dst = CppLinq::ConcatAll(rng1, rng2, rng3, CppLinq::Range(7, 9, 1));
+
+	IsEqualArray(dst, ans);
+}
+
+TEST(ConcatAll, KnownSize)
+{
+	int src1[] = { 1, 2 };
+	std::vector<int> src2 = { 3, 4, 5 };
+
+	auto dst = CppLinq::ConcatAll(CppLinq::From(src1), CppLinq::From(src2), CppLinq::From(src1).Select([](int a) { return a * 10; }));
+
+	EXPECT_EQ(7u, dst.m_enumerator.Size());
+	EXPECT_EQ(7, dst.Count());
+
+	dst.NextObject();
+	dst.NextObject();
+	dst.NextObject();
+	EXPECT_EQ(4u, dst.m_enumerator.Size());
+	EXPECT_EQ(CppLinq::UnknownSize, CppLinq::ConcatAll(CppLinq::From(src1), CppLinq::From(src1).Where([](int) { return true; })).m_enumerator.Size());
+}
+
+TEST(ConcatAll, VectorOfSources)
+{
+	std::vector<int> src = { 1, 2, 3 };
+	int ans[] = { 1, 2, 3, 2, 3, 3 };
+
+	std::vector<decltype(CppLinq::From(src).Skip(0))> sources;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		sources.push_back(CppLinq::From(src).Skip(i));
+	}
+
+	IsEqualArray(CppLinq::ConcatAll(sources), ans);
+}
+
+TEST(ConcatAll, FlattenedConcat)
+{
+	int src1[] = { 1, 2 };
+	int src2[] = { 3 };
+	int ans[] = { 1, 2, 3, 1, 2, 3 };
+
+	auto rng1 = CppLinq::From(src1);
+	auto rng2 = CppLinq::From(src2);
+	auto dst = rng1.Concat(rng2).Concat(rng1).Concat(rng2);
+
+	EXPECT_TRUE((std::is_same<decltype(dst.m_enumerator), CppLinq::ConcatEnumerator<decltype(rng1.m_enumerator), decltype(rng2.m_enumerator),
+		decltype(rng1.m_enumerator), decltype(rng2.m_enumerator)>>::value));
+	IsEqualArray(dst, ans);
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+namespace
+{
+	constexpr int src[] = { 4, 5, 3, 1, 4, 2, 1, 4, 6 };
+
+	constexpr auto table = CppLinq::StaticFrom(src)
+		.Where([](int a) { return a % 2 == 0; })
+		.Select([](int a) { return a * 10; })
+		.OrderBy()
+		.ToArray<5>();
+
+	static_assert(table[0] == 20 && table[1] == 40 && table[3] == 40 && table[4] == 60, "Where/Select/OrderBy at compile time");
+	static_assert(CppLinq::StaticFrom(src).Distinct().Count() == 6, "Distinct at compile time");
+	static_assert(CppLinq::StaticRange<16>(0, 10, 3).Sum() == 18, "Range at compile time");
+	static_assert(CppLinq::StaticRepeat<4>(7).All([](int a) { return a == 7; }), "Repeat at compile time");
+}
+
+TEST(Constexpr, ArrayTable)
+{
+	int ans[] = { 20, 40, 40, 40, 60 };
+
+	for (size_t i = 0; i < 5; ++i)
+	{
+		EXPECT_EQ(ans[i], table[i]);
+	}
+}
+
+TEST(Constexpr, Operators)
+{
+	constexpr auto rng = CppLinq::StaticRange<8>(1, 20, 2);
+
+	EXPECT_EQ(8u, rng.Count());
+	EXPECT_EQ(15, rng.Max());
+	EXPECT_EQ(1, rng.Min());
+	EXPECT_EQ(13, rng.Reverse().Skip(1).First());
+	EXPECT_TRUE(rng.Take(3).Contains(5));
+	EXPECT_FALSE(rng.Any([](int a) { return a % 2 == 0; }));
+	EXPECT_THROW(rng.ElementAt(8), CppLinq::EnumeratorEndException);
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+TEST(Container, SetLookups)
+{
+	std::set<int> src;
+
+	for (int i = 0; i < 1000000; ++i)
+	{
+		src.insert(i * 2);
+	}
+
+	auto rng = CppLinq::From(src);
+
+	EXPECT_TRUE((CppLinq::IsContainerEnumerator<decltype(rng.m_enumerator)>::value));
+	EXPECT_TRUE(rng.Contains(123456));
+	EXPECT_FALSE(rng.Contains(123457));
+	EXPECT_EQ(1u, rng.Count(1999998));
+	EXPECT_EQ(0u, rng.Count(-2));
+	EXPECT_EQ(1000000u, rng.Count());
+	EXPECT_EQ(0, rng.Min());
+	EXPECT_EQ(1999998, rng.Max());
+	EXPECT_EQ(1999998, rng.Last());
+	EXPECT_EQ(3u, rng.Where([](int a) { return a < 6; }).Count());
+}
+
+TEST(Container, MultisetAndCustomOrder)
+{
+	std::multiset<int> src = { 3, 1, 3, 2, 3 };
+	std::set<int, std::greater<int>> descending = { 1, 5, 3 };
+	int ans[] = { 5, 3, 1 };
+
+	auto rng = CppLinq::From(src);
+
+	EXPECT_EQ(3u, rng.Count(3));
+	EXPECT_EQ(5u, rng.Count());
+	EXPECT_EQ(3, rng.Max());
+	IsEqualArray(CppLinq::From(descending), ans);
+	EXPECT_FALSE((CppLinq::IsSortedEnumerator<decltype(CppLinq::From(descending).m_enumerator)>::value));
+	EXPECT_EQ(5, CppLinq::From(descending).Max());
+	EXPECT_EQ(1, CppLinq::From(descending).Last());
+	EXPECT_TRUE(CppLinq::From(descending).Contains(3));
+}
+
+TEST(Container, MapLookups)
+{
+	std::map<int, char> src = { { 1, 'a' }, { 2, 'b' }, { 3, 'c' } };
+	std::multimap<int, char> multi = { { 1, 'a' }, { 1, 'b' }, { 1, 'a' } };
+
+	auto rng = CppLinq::From(src);
+
+	EXPECT_TRUE(rng.Contains(std::make_pair(2, 'b')));
+	EXPECT_FALSE(rng.Contains(std::make_pair(2, 'c')));
+	EXPECT_EQ(std::make_pair(3, 'c'), rng.Max());
+	EXPECT_EQ(std::make_pair(3, 'c'), rng.Last());
+	EXPECT_EQ(2u, CppLinq::From(multi).Count(std::make_pair(1, 'a')));
+	EXPECT_EQ(3u, CppLinq::From(multi).Count());
+}
+
+TEST(Container, LookupsAfterPull)
+{
+	std::set<int> src = { 1, 2, 3 };
+	std::map<int, char> map = { { 1, 'a' }, { 2, 'b' } };
+
+	auto rng = CppLinq::From(src);
+	rng.NextObject();
+
+	EXPECT_FALSE(rng.Contains(1));
+	EXPECT_TRUE(rng.Contains(3));
+	EXPECT_EQ(0u, rng.Count(1));
+	EXPECT_EQ(1u, rng.Count(2));
+	EXPECT_EQ(3, rng.Max());
+
+	rng.NextObject();
+	rng.NextObject();
+
+	EXPECT_THROW(rng.Max(), CppLinq::EnumeratorEndException);
+	EXPECT_THROW(rng.Last(), CppLinq::EnumeratorEndException);
+
+	auto pairs = CppLinq::From(map);
+	pairs.NextObject();
+
+	EXPECT_FALSE(pairs.Contains(std::make_pair(1, 'a')));
+	EXPECT_EQ(1u, pairs.Count(std::make_pair(2, 'b')));
+}
+
+TEST(Container, UnorderedLookups)
+{
+	std::unordered_set<int> src = { 4, 8, 15, 16, 23, 42 };
+	std::unordered_map<std::string, int> map = { { "one", 1 }, { "two", 2 } };
+
+	auto rng = CppLinq::From(src);
+
+	EXPECT_TRUE(rng.Contains(15));
+	EXPECT_FALSE(rng.Contains(14));
+	EXPECT_EQ(1u, rng.Count(42));
+	EXPECT_EQ(6u, rng.Count());
+	EXPECT_EQ(108, rng.Sum());
+	EXPECT_EQ(42, rng.Max());
+	EXPECT_TRUE(CppLinq::From(map).Contains(std::make_pair(std::string("two"), 2)));
+	EXPECT_EQ(3, CppLinq::From(map).Sum([](const std::pair<std::string, int>& a) { return a.second; }));
+}
\ No newline at end of file
@@ -2,11 +2,43 @@
 #define CPP_LINQ_H
 
 #include <set>
+#include <new>
+#include <map>
 #include <list>
+#include <array>
+#include <cmath>
 #include <deque>
+#include <mutex>
+#include <tuple>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <utility>
+#include <numeric>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
 #include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#if __has_include(<ranges>)
+#include <ranges>
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#endif
 
 namespace CppLinq
 {
@@ -26,13 +58,56 @@ namespace CppLinq
 			
 		}
 
+		// Enumerator whose function reports the end by returning std::nullopt instead of throwing
+		template <typename Func, typename = std::enable_if_t<std::is_same<std::invoke_result_t<Func&, Arg&>, std::optional<Ret>>::value>>
+		Enumerator(Func tryNextObject, Arg data) :
+			m_tryNextObject(tryNextObject), m_data(data)
+		{
+
+		}
+
 		Ret NextObject()
 		{
+			if (m_tryNextObject)
+			{
+				std::optional<Ret> object = m_tryNextObject(m_data);
+
+				if (!object)
+				{
+					throw EnumeratorEndException();
+				}
+
+				return std::move(*object);
+			}
+
 			return m_nextObject(m_data);
 		}
 
+		std::optional<Ret> TryNextObject()
+		{
+			if (m_tryNextObject)
+			{
+				return m_tryNextObject(m_data);
+			}
+
+			try
+			{
+				return m_nextObject(m_data);
+			}
+			catch (EnumeratorEndException&)
+			{
+				return std::nullopt;
+			}
+		}
+
+		const Arg& Data() const
+		{
+			return m_data;
+		}
+
 	private:
 		std::function<Ret(Arg&)> m_nextObject;
+		std::function<std::optional<Ret>(Arg&)> m_tryNextObject;
 		Arg m_data;
 	};
 
@@ -54,6 +129,241 @@ namespace CppLinq
 		return stream;
 	}
 
+	// Unknown Size (returned by enumerators that cannot tell how many objects are left)
+	constexpr std::size_t UnknownSize = static_cast<std::size_t>(-1);
+
+	template <typename Enum, typename = void>
+	struct HasSize : std::false_type { };
+
+	template <typename Enum>
+	struct HasSize<Enum, decltype(void(std::declval<const Enum&>().Size()))> : std::true_type { };
+
+	// Size Of (number of objects left in an enumerator, or UnknownSize)
+	template <typename Enum>
+	std::size_t SizeOf(const Enum& enumerator)
+	{
+		if constexpr (HasSize<Enum>::value)
+		{
+			return enumerator.Size();
+		}
+		else
+		{
+			return UnknownSize;
+		}
+	}
+
+	template <typename Container, typename = void>
+	struct HasReserve : std::false_type { };
+
+	template <typename Container>
+	struct HasReserve<Container, decltype(void(std::declval<Container&>().reserve(std::size_t())))> : std::true_type { };
+
+	// Reserve (room for size objects when the container can reserve and the size is known)
+	template <typename Container>
+	void Reserve(Container& container, std::size_t size)
+	{
+		if constexpr (HasReserve<Container>::value)
+		{
+			if (size != UnknownSize)
+			{
+				container.reserve(size);
+			}
+		}
+	}
+
+	// Contiguous iterators (pointers and std::vector iterators over the enumerated type)
+	template <typename Type, typename Iter>
+	struct IsContiguousIterator : std::integral_constant<bool, std::is_same<typename std::iterator_traits<Iter>::value_type, Type>::value &&
+		(std::is_pointer<Iter>::value || (!std::is_same<Type, bool>::value &&
+		(std::is_same<Iter, typename std::vector<Type>::iterator>::value || std::is_same<Iter, typename std::vector<Type>::const_iterator>::value)))> { };
+
+	template <typename Enum>
+	struct IsContiguousEnumerator : std::false_type { };
+
+	// Sorted enumerators (objects come out in ascending operator< order)
+	template <typename Enum>
+	struct IsSortedEnumerator : std::false_type { };
+
+	// Container enumerators (sources that keep a reference to an associative container)
+	template <typename Enum>
+	struct IsContainerEnumerator : std::false_type { };
+
+	// Table enumerators (rows of a ColumnTable, read column by column)
+	template <typename Enum>
+	struct IsTableEnumerator : std::false_type { };
+
+	// Associative containers (std::set, std::map and their multi and unordered variants)
+	template <typename Container>
+	struct IsAssociativeContainer : std::false_type { };
+
+	template <typename T, typename S, typename U>
+	struct IsAssociativeContainer<std::set<T, S, U>> : std::true_type { };
+
+	template <typename T, typename S, typename U>
+	struct IsAssociativeContainer<std::multiset<T, S, U>> : std::true_type { };
+
+	template <typename K, typename T, typename S, typename U>
+	struct IsAssociativeContainer<std::map<K, T, S, U>> : std::true_type { };
+
+	template <typename K, typename T, typename S, typename U>
+	struct IsAssociativeContainer<std::multimap<K, T, S, U>> : std::true_type { };
+
+	template <typename T, typename H, typename E, typename U>
+	struct IsAssociativeContainer<std::unordered_set<T, H, E, U>> : std::true_type { };
+
+	template <typename T, typename H, typename E, typename U>
+	struct IsAssociativeContainer<std::unordered_multiset<T, H, E, U>> : std::true_type { };
+
+	template <typename K, typename T, typename H, typename E, typename U>
+	struct IsAssociativeContainer<std::unordered_map<K, T, H, E, U>> : std::true_type { };
+
+	template <typename K, typename T, typename H, typename E, typename U>
+	struct IsAssociativeContainer<std::unordered_multimap<K, T, H, E, U>> : std::true_type { };
+
+	// Ordered containers with the default comparator enumerate in ascending order (keys of a std::map
+	// are unique, so its pairs are sorted too)
+	template <typename Container>
+	struct IsAscendingContainer : std::false_type { };
+
+	template <typename T, typename U>
+	struct IsAscendingContainer<std::set<T, std::less<T>, U>> : std::true_type { };
+
+	template <typename T, typename U>
+	struct IsAscendingContainer<std::multiset<T, std::less<T>, U>> : std::true_type { };
+
+	template <typename K, typename T, typename U>
+	struct IsAscendingContainer<std::map<K, T, std::less<K>, U>> : std::true_type { };
+
+	// Map containers (objects are key and mapped value pairs, looked up by key)
+	template <typename Container, typename = void>
+	struct IsMapContainer : std::false_type { };
+
+	template <typename Container>
+	struct IsMapContainer<Container, decltype(void(std::declval<typename Container::mapped_type>()))> : std::true_type { };
+
+	// Ordered containers (bidirectional iterators, so the last object is at rbegin)
+	template <typename Container, typename = void>
+	struct IsOrderedContainer : std::false_type { };
+
+	template <typename Container>
+	struct IsOrderedContainer<Container, decltype(void(std::declval<typename Container::key_compare>()))> : std::true_type { };
+
+	// Container Value (the enumerated type: std::pair<K, T> for maps, the value type otherwise)
+	template <typename Container, bool = IsMapContainer<Container>::value>
+	struct ContainerValue
+	{
+		using type = typename Container::value_type;
+	};
+
+	template <typename Container>
+	struct ContainerValue<Container, true>
+	{
+		using type = std::pair<typename Container::key_type, typename Container::mapped_type>;
+	};
+
+	// Wide Type (64-bit for integers, so sums over billions of 32-bit objects cannot overflow; other
+	// types are used as they are)
+	template <typename Type, typename = void>
+	struct WideType
+	{
+		using type = Type;
+	};
+
+	template <typename Type>
+	struct WideType<Type, typename std::enable_if<std::is_integral<Type>::value>::type>
+	{
+		using type = typename std::conditional<std::is_signed<Type>::value, std::int64_t, std::uint64_t>::type;
+	};
+
+	// Offset Type (unsigned integer type, at least as wide as int, in which differences and offsets
+	// within an integer sequence wrap instead of overflowing; other types are used as they are)
+	template <typename Type, typename = void>
+	struct OffsetType
+	{
+		using type = Type;
+	};
+
+	template <typename Type>
+	struct OffsetType<Type, typename std::enable_if<std::is_integral<Type>::value && !std::is_same<Type, bool>::value>::type>
+	{
+		using type = typename std::make_unsigned<decltype(std::declval<Type>() + 0)>::type;
+	};
+
+	// Hashable types (std::hash is enabled for them)
+	template <typename Type, typename = void>
+	struct IsHashable : std::false_type { };
+
+	template <typename Type>
+	struct IsHashable<Type, decltype(void(std::hash<Type>()(std::declval<const Type&>())))> : std::true_type { };
+
+	// Lookup Set (hash set when the type is hashable, ordered set otherwise)
+	template <typename Type>
+	using LookupSet = typename std::conditional<IsHashable<Type>::value, std::unordered_set<Type>, std::set<Type>>::type;
+
+	// Lookup Map (hash map when the key is hashable, ordered map otherwise)
+	template <typename Key, typename Value>
+	using LookupMap = typename std::conditional<IsHashable<Key>::value, std::unordered_map<Key, Value>, std::map<Key, Value>>::type;
+
+	template <typename Enum, typename = void>
+	struct HasForEachRemaining : std::false_type { };
+
+	template <typename Enum>
+	struct HasForEachRemaining<Enum, decltype(std::declval<Enum&>().ForEachRemaining(std::declval<void (*&)(typename Enum::value_type&)>()))> : std::true_type { };
+
+	// For Each Remaining (calls action with every object left in an enumerator)
+	// Enumerators that provide their own loop are walked without the end-of-sequence exception.
+	template <typename Enum, typename Action>
+	void ForEachRemaining(Enum& enumerator, Action&& action)
+	{
+		if constexpr (HasForEachRemaining<Enum>::value)
+		{
+			enumerator.ForEachRemaining(action);
+		}
+		else
+		{
+			try
+			{
+				while (true)
+				{
+					typename Enum::value_type object = enumerator.NextObject();
+					action(object);
+				}
+			}
+			catch (EnumeratorEndException&)
+			{
+
+			}
+		}
+	}
+
+	template <typename Enum, typename = void>
+	struct HasTryNextObject : std::false_type { };
+
+	template <typename Enum>
+	struct HasTryNextObject<Enum, decltype(void(std::declval<Enum&>().TryNextObject()))> : std::true_type { };
+
+	// Try Next Object (next object of an enumerator, or nothing at the end of the sequence)
+	// Enumerators that can tell their end report it without the end-of-sequence exception.
+	template <typename Enum>
+	std::optional<typename Enum::value_type> TryNextObject(Enum& enumerator)
+	{
+		if constexpr (HasTryNextObject<Enum>::value)
+		{
+			return enumerator.TryNextObject();
+		}
+		else
+		{
+			try
+			{
+				return enumerator.NextObject();
+			}
+			catch (EnumeratorEndException&)
+			{
+				return std::nullopt;
+			}
+		}
+	}
+
 	// Iterator and Container Pair
 	template <typename Iter, typename Container>
 	class IteratorContainerPair
@@ -79,762 +389,7537 @@ namespace CppLinq
 			}
 		}
 	};
-	
-	// Linq Object
-	template<typename Enum>
-	class LinqObject
-	{
-		using Type = typename Enum::value_type;
 
-		template <typename Func, typename Arg>
-		static auto GetReturnType(Func* func = nullptr, Arg* arg1 = nullptr)
-			-> decltype((*func)(*arg1));
+	// Span (non-owning view of contiguous objects)
+	template <typename Type>
+	class Span
+	{
+	public:
+		Span(Type* data, std::size_t size) :
+			m_data(data), m_size(size)
+		{
 
-		template <typename Func, typename Arg1, typename Arg2>
-		static auto GetReturnType(Func* func = nullptr, Arg1* arg1 = nullptr, Arg2* arg2 = nullptr)
-			-> decltype((*func)(*arg1, *arg2));
+		}
 
-		// Select Internal
-		template <typename Ret>
-		LinqObject<Enumerator<Ret, std::pair<Enum, int>>> SelectInternal(std::function<Ret(Type, int)> transform) const
+		Type* Data() const
 		{
-			return Enumerator<Ret, std::pair<Enum, int>>([=](std::pair<Enum, int>& pair) -> Ret
-			{
-				return transform(pair.first.NextObject(), pair.second++);
-			}, std::make_pair(m_enumerator, 0));
+			return m_data;
 		}
 
-		template <typename Func>
-		LinqObject<Enumerator<decltype(GetReturnType<Func, Type, int>()), std::pair<Enum, int>>> SelectInternal(Func transform) const
+		std::size_t Size() const
 		{
-			return SelectInternal<decltype(GetReturnType<Func, Type, int>())>(transform);
+			return m_size;
 		}
 
-		// Where Internal
-		LinqObject<Enumerator<Type, std::pair<Enum, int>>> WhereInternal(std::function<bool(Type, int)> predicate) const
+		Type& operator[](std::size_t index) const
 		{
-			return Enumerator<Type, std::pair<Enum, int>>([=](std::pair<Enum, int>& pair) -> Type
-			{
-				Type object;
+			return m_data[index];
+		}
 
-				do
-				{
-					object = pair.first.NextObject();
-				} while (!predicate(object, pair.second++));
+		Type* begin() const
+		{
+			return m_data;
+		}
 
-				return object;
-			}, std::make_pair(m_enumerator, 0));
+		Type* end() const
+		{
+			return m_data + m_size;
 		}
 
-		// Foreach Internal
-		void ForeachInternal(std::function<void(Type, int)> action) const
+	private:
+		Type* m_data;
+		std::size_t m_size;
+	};
+
+	// Any Enumerable (type-erased enumerator)
+	// Stores any enumerator yielding Type in a small inline buffer (falling back to the heap
+	// for large pipelines). Objects are pulled only as far as the caller asks: one per virtual call
+	// through NextObject, a caller-sized batch per call through NextBatch, and everything that is
+	// left in a single virtual call through ForEachRemaining.
+	template <typename Type>
+	class AnyEnumerable
+	{
+		static constexpr std::size_t InlineSize = 128;
+
+		class Holder
 		{
-			auto en = m_enumerator;
-			int index = 0;
+		public:
+			virtual ~Holder() = default;
 
-			try
+			virtual std::optional<Type> TryNextObject() = 0;
+			virtual std::size_t NextBatch(Span<Type> batch) = 0;
+			virtual void ForEachRemaining(void (*action)(void*, Type&), void* context) = 0;
+			virtual std::size_t Size() const = 0;
+			virtual Holder* CloneTo(void* buffer) const = 0;
+			virtual Holder* MoveTo(void* buffer) = 0;
+		};
+
+		template <typename Enum>
+		class HolderImpl : public Holder
+		{
+		public:
+			static constexpr bool FitsInline()
 			{
-				while (true)
-				{
-					action(en.NextObject(), index++);
-				}
+				return sizeof(HolderImpl) <= InlineSize && alignof(HolderImpl) <= alignof(std::max_align_t);
 			}
-			catch (EnumeratorEndException&)
+
+			static void* Allocate(void* buffer)
 			{
-				
+				return FitsInline() ? buffer : ::operator new(sizeof(HolderImpl));
 			}
-		}
 
-		// TakeWhile Internal
-		LinqObject<Enumerator<Type, std::pair<Enum, int>>> TakeWhileInternal(std::function<bool(Type, int)> predicate) const
-		{
-			return Enumerator<Type, std::pair<Enum, int>>([=](std::pair<Enum, int>& pair) -> Type
+			HolderImpl(Enum enumerator) :
+				m_enumerator(std::move(enumerator))
 			{
-				Type object = pair.first.NextObject();
 
-				if (!predicate(object, pair.second++))
-				{
-					throw EnumeratorEndException();
-				}
+			}
 
-				return object;
-			}, std::make_pair(m_enumerator, 0));
-		}
+			std::optional<Type> TryNextObject() override
+			{
+				return CppLinq::TryNextObject(m_enumerator);
+			}
 
-		// SkipWhile Internal
-		LinqObject<Enumerator<Type, std::pair<Enum, int>>> SkipWhileInternal(std::function<bool(Type, int)> predicate) const
-		{
-			return Enumerator<Type, std::pair<Enum, int>>([=](std::pair<Enum, int>& pair) -> Type
+			std::size_t NextBatch(Span<Type> batch) override
 			{
-				if (pair.second != 0)
+				std::size_t count = 0;
+
+				for (; count < batch.Size(); ++count)
 				{
-					return pair.first.NextObject();
+					std::optional<Type> object = CppLinq::TryNextObject(m_enumerator);
+
+					if (!object)
+					{
+						break;
+					}
+
+					batch[count] = std::move(*object);
 				}
 
-				Type object;
+				return count;
+			}
 
-				do
+			void ForEachRemaining(void (*action)(void*, Type&), void* context) override
+			{
+				CppLinq::ForEachRemaining(m_enumerator, [&](Type& object)
 				{
-					object = pair.first.NextObject();
-				} while (predicate(object, pair.second++));
+					action(context, object);
+				});
+			}
 
-				return object;
-			}, std::make_pair(m_enumerator, 0));
-		}
+			std::size_t Size() const override
+			{
+				return SizeOf(m_enumerator);
+			}
 
-		// Aggregate
-		template <typename Ret>
-		Ret Aggregate(Ret start, std::function<Ret(Ret, Type)> accumulate) const
-		{
-			try
+			Holder* CloneTo(void* buffer) const override
 			{
-				auto en = m_enumerator;
-				
-				while (true)
-				{
-					start = accumulate(start, en.NextObject());
-				}
+				return new (Allocate(buffer)) HolderImpl(*this);
 			}
-			catch (EnumeratorEndException&)
+
+			Holder* MoveTo(void* buffer) override
 			{
-				
+				return new (Allocate(buffer)) HolderImpl(std::move(*this));
 			}
 
-			return start;
+		private:
+			Enum m_enumerator;
+		};
+
+		bool IsInline() const
+		{
+			return reinterpret_cast<const void*>(m_holder) == static_cast<const void*>(&m_buffer);
 		}
 
-		// Elect
-		Type Elect(std::function<Type(Type, Type)> accumulate) const
+		void Reset()
 		{
-			auto en = m_enumerator;
-			Type result = en.NextObject();
+			if (m_holder == nullptr)
+			{
+				return;
+			}
 
-			try
+			if (IsInline())
 			{
-				while (true)
-				{
-					result = accumulate(result, en.NextObject());
-				}
+				m_holder->~Holder();
 			}
-			catch (EnumeratorEndException&)
+			else
 			{
-
+				delete m_holder;
 			}
 
-			return result;
+			m_holder = nullptr;
 		}
 
-	protected:
-		template <typename Type, typename Ret>
-		class TransformComparer
+		// Takes over the holder of other, leaving other empty
+		void Take(AnyEnumerable& other)
 		{
-		public:
-			std::function<Ret(Type)> m_func;
-
-			TransformComparer(std::function<Ret(Type)> func) :
-				m_func(func)
+			if (other.m_holder != nullptr && other.IsInline())
 			{
-				
+				m_holder = other.m_holder->MoveTo(&m_buffer);
+				other.Reset();
 			}
-
-			bool operator()(const Type& a, const Type& b) const
+			else
 			{
-				return m_func(a) < m_func(b);
+				std::swap(m_holder, other.m_holder);
 			}
-		};
+		}
 
 	public:
-		Enum m_enumerator;
-
-		using value_type = typename Enum::value_type;
+		using value_type = Type;
 
-		LinqObject(Enum enumerator) : m_enumerator(enumerator)
+		template <typename Enum, typename = typename std::enable_if<!std::is_same<typename std::decay<Enum>::type, AnyEnumerable>::value>::type>
+		AnyEnumerable(Enum enumerator) :
+			m_holder(nullptr)
 		{
+			using Impl = HolderImpl<Enum>;
 
+			m_holder = new (Impl::Allocate(&m_buffer)) Impl(std::move(enumerator));
 		}
 
-		Type NextObject()
+		// A moved-from AnyEnumerable is empty, and so are its copies
+		AnyEnumerable(const AnyEnumerable& other) :
+			m_holder((other.m_holder != nullptr) ? other.m_holder->CloneTo(&m_buffer) : nullptr)
 		{
-			return m_enumerator.NextObject();
+
 		}
 
-		// Select
-		template <typename Ret>
-		LinqObject<Enumerator<Ret, std::pair<Enum, int>>> Select(std::function<Ret(Type)> transform) const
+		AnyEnumerable(AnyEnumerable&& other) :
+			m_holder(nullptr)
 		{
-			return SelectInternal<Ret>([=](Type a, int) { return transform(a); });
+			Take(other);
 		}
 
-		template <typename Func>
-		LinqObject<Enumerator<decltype(GetReturnType<Func, Type>()), std::pair<Enum, int>>> Select(Func transform) const
+		AnyEnumerable& operator=(AnyEnumerable other)
 		{
-			return Select<decltype(GetReturnType<Func, Type>())>(transform);
+			Reset();
+			Take(other);
+
+			return *this;
 		}
 
-		// Where
-		LinqObject<Enumerator<Type, std::pair<Enum, int>>> Where(std::function<bool(Type)> predicate) const
+		~AnyEnumerable()
 		{
-			return WhereInternal([=](Type a, int) { return predicate(a); });
+			Reset();
 		}
 
-		// OrderBy
-		template <typename Ret>
-		LinqObject<Enumerator<Type, IteratorContainerPair<typename std::multiset<Type, TransformComparer<Type, Ret>>::iterator,
-			std::multiset<Type, TransformComparer<Type, Ret>>>>> OrderBy(std::function<Ret(Type)> transform) const
+		Type NextObject()
 		{
-			using DataType = IteratorContainerPair<typename std::multiset<Type, TransformComparer<Type, Ret>>::iterator,
-				std::multiset<Type, TransformComparer<Type, Ret>>>;
+			std::optional<Type> object = TryNextObject();
+			return object ? std::move(*object) : throw EnumeratorEndException();
+		}
 
-			std::multiset<Type, TransformComparer<Type, Ret>> objects(transform);
+		std::optional<Type> TryNextObject()
+		{
+			return (m_holder != nullptr) ? m_holder->TryNextObject() : std::nullopt;
+		}
 
-			try
+		// Fills up to batch.Size() objects and returns how many were written (0 at the end)
+		std::size_t NextBatch(Span<Type> batch)
+		{
+			return (m_holder != nullptr) ? m_holder->NextBatch(batch) : 0;
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			if (m_holder != nullptr)
 			{
-				auto en = m_enumerator;
-				while (true)
+				m_holder->ForEachRemaining([](void* context, Type& object)
 				{
-					objects.insert(en.NextObject());
-				}
-			}
-			catch (EnumeratorEndException&)
-			{
-				
+					(*static_cast<typename std::remove_reference<Action>::type*>(context))(object);
+				}, &action);
 			}
-
-			return Enumerator<Type, DataType>([](DataType& pair)
-			{
-				return (pair.m_first == pair.m_second.end()) ?
-					throw EnumeratorEndException() : *(pair.m_first++);
-			}, DataType(objects, [](const std::multiset<Type, TransformComparer<Type, Ret>>& mulSet) { return mulSet.begin(); }));
 		}
 
-		template <typename Func>
-		LinqObject<Enumerator<Type, IteratorContainerPair<typename std::multiset<Type, TransformComparer<Type, decltype(GetReturnType<Func, Type>())>>::iterator,
-			std::multiset<Type, TransformComparer<Type, decltype(GetReturnType<Func, Type>())>>>>> OrderBy(Func transform) const
+		std::size_t Size() const
 		{
-			return OrderBy<decltype(GetReturnType<Func, Type>())>(transform);
+			return (m_holder != nullptr) ? m_holder->Size() : 0;
 		}
 
-		LinqObject<Enumerator<Type, IteratorContainerPair<typename std::multiset<Type, TransformComparer<Type, Type>>::iterator,
-			std::multiset<Type, TransformComparer<Type, Type>>>>> OrderBy() const
+	private:
+		typename std::aligned_storage<InlineSize, alignof(std::max_align_t)>::type m_buffer;
+		Holder* m_holder;
+	};
+
+	// Identity Transform
+	class IdentityTransform
+	{
+	public:
+		template <typename Type>
+		Type operator()(const Type& object) const
 		{
-			return OrderBy<Type>([](Type a) { return a; });
+			return object;
 		}
+	};
 
-		// Foreach
-		void Foreach(std::function<void(Type)> action) const
+	// Where Enumerator
+	template <typename Enum, typename Func>
+	class WhereEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		WhereEnumerator(Enum source, Func predicate) :
+			m_source(source), m_predicate(predicate)
 		{
-			ForeachInternal([=](Type a, int) { return action(a); });
+
 		}
 
-		// Take
-		LinqObject<Enumerator<Type, std::pair<Enum, int>>> Take(int count) const
+		value_type NextObject()
 		{
-			return WhereInternal([=](Type, int i)
+			while (true)
 			{
-				if (i == count)
+				value_type object = m_source.NextObject();
+
+				if (m_predicate(object))
 				{
-					throw EnumeratorEndException();
+					return object;
 				}
-
-				return true;
-			});
+			}
 		}
 
-		// TakeWhile
-		LinqObject<Enumerator<Type, std::pair<Enum, int>>> TakeWhile(std::function<bool(Type)> predicate) const
+		std::optional<value_type> TryNextObject()
 		{
-			return TakeWhileInternal([=](Type t, int) { return predicate(t); });
+			for (std::optional<value_type> object = CppLinq::TryNextObject(m_source); object; object = CppLinq::TryNextObject(m_source))
+			{
+				if (m_predicate(*object))
+				{
+					return object;
+				}
+			}
+
+			return std::nullopt;
 		}
 
-		// Skip
-		LinqObject<Enumerator<Type, std::pair<Enum, int>>> Skip(int count) const
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
 		{
-			return WhereInternal([=](Type, int i) { return i >= count; });
+			CppLinq::ForEachRemaining(m_source, [&](value_type& object)
+			{
+				if (m_predicate(object))
+				{
+					action(object);
+				}
+			});
 		}
 
-		// SkipWhile
-		LinqObject<Enumerator<Type, std::pair<Enum, int>>> SkipWhile(std::function<bool(Type)> predicate) const
+		const Enum& Source() const
 		{
-			return SkipWhileInternal([=](Type t, int) { return predicate(t); });
+			return m_source;
 		}
 
-		// Cast
-		template <typename Ret>
-		LinqObject<Enumerator<Ret, std::pair<Enum, int>>> Cast() const
+		const Func& Predicate() const
 		{
-			return SelectInternal<Ret>([=](Type a) { return a; });
+			return m_predicate;
 		}
 
-		// Distinct
-		template <typename Ret>
-		LinqObject<Enumerator<Type, std::pair<Enum, std::set<Ret>>>> Distinct(std::function<Ret(Type)> transform) const
-		{
-			using DataType = std::pair<Enum, std::set<Ret>>;
+	private:
+		Enum m_source;
+		Func m_predicate;
+	};
 
-			return Enumerator<Type, DataType>([=](DataType& pair) -> Type
-			{
-				while (true)
-				{
-					Type object = pair.first.NextObject();
-					Ret key = transform(object);
+	// Select Enumerator
+	template <typename Enum, typename Func>
+	class SelectEnumerator
+	{
+	public:
+		using value_type = typename std::decay<decltype(std::declval<Func&>()(std::declval<typename Enum::value_type&>()))>::type;
+
+		SelectEnumerator(Enum source, Func transform) :
+			m_source(source), m_transform(transform)
+		{
 
-					if (pair.second.find(key) == pair.second.end())
-					{
-						pair.second.insert(key);
-						return object;
-					}
-				}
-			}, std::make_pair(m_enumerator, std::set<Ret>()));
 		}
 
-		template <typename Func>
-		LinqObject<Enumerator<Type, std::pair<Enum, std::set<decltype(GetReturnType<Func, Type>())>>>> Distinct(Func transform) const
+		value_type NextObject()
 		{
-			return Distinct<decltype(GetReturnType<Func, Type>())>(transform);
+			typename Enum::value_type object = m_source.NextObject();
+			return m_transform(object);
 		}
 
-		LinqObject<Enumerator<Type, std::pair<Enum, std::set<Type>>>> Distinct() const
+		std::optional<value_type> TryNextObject()
 		{
-			return Distinct<Type>([](Type a) { return a; });
+			std::optional<typename Enum::value_type> object = CppLinq::TryNextObject(m_source);
+			return object ? std::optional<value_type>(m_transform(*object)) : std::nullopt;
 		}
-		
-		// Reverse
-		LinqObject<Enumerator<Type, IteratorContainerPair<typename std::vector<Type>::const_reverse_iterator, std::vector<Type>>>> Reverse() const
-		{
-			using DataType = IteratorContainerPair<typename std::vector<Type>::const_reverse_iterator, std::vector<Type>>;
 
-			return Enumerator<Type, DataType>([](DataType& pair)
-			{
-				return (pair.m_first == pair.m_second.crend()) ?
-					throw EnumeratorEndException() : *(pair.m_first++);
-			}, DataType(ToVector(), [](const std::vector<Type>& vec) {return vec.crbegin(); }));
+		std::size_t Size() const
+		{
+			return SizeOf(m_source);
 		}
 
-		// Sum
-		template <typename Ret>
-		Ret Sum(std::function<Ret(Type)> transform) const
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
 		{
-			return Aggregate<Ret>(Ret(), [=](Ret accumulator, Type object)
+			CppLinq::ForEachRemaining(m_source, [&](typename Enum::value_type& source)
 			{
-				return accumulator + transform(object);
+				value_type object = m_transform(source);
+				action(object);
 			});
 		}
 
-		template <typename Func>
-		decltype(GetReturnType<Func, Type>()) Sum(Func transform) const
+		const Enum& Source() const
 		{
-			return Sum<decltype(GetReturnType<Func, Type>())>(transform);
+			return m_source;
 		}
 
-		template <typename Ret>
-		Ret Sum() const
+		const Func& Transform() const
 		{
-			return Sum<Ret>([](Type a) { return a; });
+			return m_transform;
 		}
 
-		Type Sum() const
-		{
-			return Sum<Type>();
-		}
+	private:
+		Enum m_source;
+		Func m_transform;
+	};
 
-		// Average
-		template <typename Ret>
-		Ret Average(std::function<Ret(Type)> transform) const
-		{
-			int count = 0;
+	// OrderBy Enumerator (stable; sorts on the first pull)
+	template <typename Enum, typename Func>
+	class OrderByEnumerator
+	{
+		template <typename Enum2, typename Func2>
+		friend class OrderByEnumerator;
 
-			return Aggregate<Ret>(Ret(), [&](Ret accumulator, Type object) -> Ret
-			{
-				count++;
-				return (accumulator * (count - 1) + transform(object)) / count;
-			});
-		}
+	public:
+		using value_type = typename Enum::value_type;
+		using key_type = typename std::decay<decltype(std::declval<Func&>()(std::declval<value_type&>()))>::type;
 
-		template <typename Func>
-		decltype(GetReturnType<Func, Type>()) Average(Func transform) const
+		OrderByEnumerator(Enum source, Func transform) :
+			m_source(source), m_transform(transform), m_isSorted(false), m_position(0)
 		{
-			return Average<decltype(GetReturnType<Func, Type>())>(transform);
-		}
 
-		template <typename Ret>
-		Ret Average() const
-		{
-			return Average<Ret>([](Type a) { return a; });
 		}
 
-		Type Average() const
+		// Keeps the objects of an already sorted enumerator that are left to enumerate and satisfy predicate
+		template <typename Enum2, typename Pred>
+		OrderByEnumerator(Enum source, const OrderByEnumerator<Enum2, Func>& sorted, Pred predicate) :
+			m_source(source), m_transform(sorted.m_transform), m_isSorted(sorted.m_isSorted), m_position(0)
 		{
-			return Average<Type>();
+			for (std::size_t i = sorted.m_position; i < sorted.m_objects.size(); ++i)
+			{
+				if (predicate(sorted.m_objects[i].second))
+				{
+					m_objects.emplace_back(sorted.m_objects[i]);
+				}
+			}
 		}
 
-		// Count
-		int Count(std::function<bool(Type)> predicate) const
+		value_type NextObject()
 		{
-			return Aggregate<int>(0, [=](int count, Type a)
+			if (!m_isSorted)
 			{
-				return count + (predicate(a) ? 1 : 0);
-			});
+				Sort();
+			}
+
+			return (m_position == m_objects.size()) ? throw EnumeratorEndException() : m_objects[m_position++].second;
 		}
 
-		int Count(const Type& value) const
+		std::optional<value_type> TryNextObject()
 		{
-			return Count([=](Type a) { return a == value; });
+			if (!m_isSorted)
+			{
+				Sort();
+			}
+
+			return (m_position == m_objects.size()) ? std::nullopt : std::optional<value_type>(m_objects[m_position++].second);
 		}
 
-		int Count() const
+		std::size_t Size() const
 		{
-			return Count([](Type) { return true; });
+			return m_isSorted ? m_objects.size() - m_position : SizeOf(m_source);
 		}
 
-		// Any
-		bool Any(std::function<bool(Type)> predicate) const
+		// First object in sorted order, found in a single pass when nothing was sorted yet
+		value_type First() const
 		{
-			try
+			if (m_isSorted)
 			{
-				auto en = m_enumerator;
+				return (m_position == m_objects.size()) ? throw EnumeratorEndException() : m_objects[m_position].second;
+			}
 
+			auto en = m_source;
+			auto transform = m_transform;
+			value_type result = en.NextObject();
+			key_type resultKey = transform(result);
+
+			try
+			{
 				while (true)
 				{
-					if (predicate(en.NextObject()))
+					value_type object = en.NextObject();
+					key_type key = transform(object);
+
+					if (key < resultKey)
 					{
-						return true;
+						result = object;
+						resultKey = key;
 					}
 				}
 			}
 			catch (EnumeratorEndException&)
 			{
-				
+
 			}
 
-			return false;
+			return result;
 		}
 
-		bool Any() const
+		const Enum& Source() const
 		{
-			return Any([](Type a) { return static_cast<bool>(a); });
+			return m_source;
 		}
 
-		// All
-		bool All(std::function<bool(Type)> predicate) const
+		const Func& Transform() const
 		{
-			return !Any([=](Type a) { return !predicate(a); });
+			return m_transform;
 		}
 
-		bool All() const
+		// Objects held by the sort buffer
+		std::size_t Buffered() const
 		{
-			return All([](Type a) { return static_cast<bool>(a); });
+			return m_objects.size();
 		}
 
-		// Contains
-		bool Contains(const Type& value) const
+	private:
+		void Sort()
 		{
-			return Any([&](Type a) { return value == a; });
+			CppLinq::ForEachRemaining(m_source, [&](value_type& object)
+			{
+				m_objects.emplace_back(m_transform(object), object);
+			});
+
+			std::stable_sort(m_objects.begin(), m_objects.end(), [](const std::pair<key_type, value_type>& a, const std::pair<key_type, value_type>& b)
+			{
+				return a.first < b.first;
+			});
+
+			m_isSorted = true;
 		}
 
-		// Max
-		template <typename Ret>
-		Type Max(std::function<Ret(Type)> transform) const
+		Enum m_source;
+		Func m_transform;
+		std::vector<std::pair<key_type, value_type>> m_objects;
+		bool m_isSorted;
+		std::size_t m_position;
+	};
+
+	template <typename Enum, typename Pred>
+	struct IsSortedEnumerator<WhereEnumerator<Enum, Pred>> : IsSortedEnumerator<Enum> { };
+
+	template <typename Enum>
+	struct IsSortedEnumerator<OrderByEnumerator<Enum, IdentityTransform>> : std::true_type { };
+
+	// Distinct keeps a subsequence of its source, whatever the key
+	template <typename Type, typename Enum, typename Key>
+	struct IsSortedEnumerator<Enumerator<Type, std::pair<Enum, std::set<Key>>>> : IsSortedEnumerator<Enum> { };
+
+	// Reverse Enumerator (buffers the source on the first pull)
+	template <typename Enum>
+	class ReverseEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		ReverseEnumerator(Enum source) :
+			m_source(source), m_isBuffered(false)
 		{
-			return Elect([=](Type a, Type b) { return transform(a) < transform(b) ? b : a; });
+
 		}
 
-		template <typename Func>
-		Type Max(Func transform) const
+		// Keeps the objects of an already buffered enumerator that are left to enumerate and satisfy predicate
+		template <typename Enum2, typename Pred>
+		ReverseEnumerator(Enum source, const ReverseEnumerator<Enum2>& buffered, Pred predicate) :
+			m_source(source), m_isBuffered(buffered.IsBuffered())
 		{
-			return Max<decltype(GetReturnType<Func, Type>())>(transform);
+			for (const value_type& object : buffered.Buffer())
+			{
+				if (predicate(object))
+				{
+					m_objects.emplace_back(object);
+				}
+			}
 		}
 
-		Type Max() const
+		value_type NextObject()
 		{
-			return Max<Type>([](Type a) { return a; });
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
 		}
 
-		// Min
-		template <typename Ret>
-		Type Min(std::function<Ret(Type)> transform) const
+		std::optional<value_type> TryNextObject()
 		{
-			return Elect([=](Type a, Type b) { return transform(a) < transform(b) ? a : b; });
+			if (!m_isBuffered)
+			{
+				CppLinq::ForEachRemaining(m_source, [&](value_type& object)
+				{
+					m_objects.emplace_back(object);
+				});
+
+				m_isBuffered = true;
+			}
+
+			if (m_objects.empty())
+			{
+				return std::nullopt;
+			}
+
+			value_type object = m_objects.back();
+			m_objects.pop_back();
+
+			return object;
 		}
 
-		template <typename Func>
-		Type Min(Func transform) const
+		std::size_t Size() const
 		{
-			return Min<decltype(GetReturnType<Func, Type>())>(transform);
+			return m_isBuffered ? m_objects.size() : SizeOf(m_source);
 		}
 
-		Type Min() const
+		const Enum& Source() const
 		{
-			return Min<Type>([](Type a) { return a; });
+			return m_source;
 		}
 
-		// ElementAt
-		Type ElementAt(size_t index) const
+		bool IsBuffered() const
 		{
-			auto en = m_enumerator;
-
-			for (size_t i = 0; i < index; ++i)
-			{
-				en.NextObject();
-			}
-
-			return en.NextObject();
+			return m_isBuffered;
 		}
 
-		// First
-		Type First(std::function<bool(Type)> predicate) const
+		std::size_t Buffered() const
 		{
-			return Where(predicate).m_enumerator.NextObject();
+			return m_objects.size();
 		}
 
-		Type First() const
+		const std::vector<value_type>& Buffer() const
 		{
-			return First([]() { return true; });
+			return m_objects;
 		}
 
-		Type FirstOrDefault(std::function<bool(Type)> predicate)
+	private:
+		Enum m_source;
+		std::vector<value_type> m_objects;
+		bool m_isBuffered;
+	};
+
+	// Concat Enumerator (flat cursor over a fixed list of sources)
+	template <typename... Enums>
+	class ConcatEnumerator
+	{
+		template <typename... Enums2>
+		friend class ConcatEnumerator;
+
+		using Sources = std::tuple<Enums...>;
+
+	public:
+		using value_type = typename std::tuple_element<0, Sources>::type::value_type;
+
+		ConcatEnumerator(Enums... sources) :
+			m_sources(sources...), m_current(0), m_remaining(SizeOf(std::get<0>(m_sources)))
 		{
-			try
-			{
-				return First(predicate);
-			}
-			catch (EnumeratorEndException&)
-			{
-				return Type();
-			}
+
 		}
 
-		Type FirstOrDefault() const
+		value_type NextObject()
 		{
-			try
-			{
-				return First();
-			}
-			catch(EnumeratorEndException&)
+			while (m_current < sizeof...(Enums))
 			{
-				return Type();
+				// A part that knows its size is left without running into its end exception
+				if (m_remaining != 0)
+				{
+					try
+					{
+						value_type object = NextFrom(m_current, std::index_sequence_for<Enums...>())(*this);
+
+						if (m_remaining != UnknownSize)
+						{
+							--m_remaining;
+						}
+
+						return object;
+					}
+					catch (EnumeratorEndException&)
+					{
+
+					}
+				}
+
+				if (++m_current < sizeof...(Enums))
+				{
+					m_remaining = SizeFrom(m_current, std::index_sequence_for<Enums...>())(*this);
+				}
 			}
+
+			throw EnumeratorEndException();
 		}
 
-		// Last
-		Type Last(std::function<bool(Type)> predicate) const
+		std::size_t Size() const
 		{
-			auto clause = Where(predicate);
-			Type object = clause.m_enumerator.NextObject();
+			std::size_t size = 0;
 
-			try
+			for (std::size_t i = m_current; i < sizeof...(Enums); ++i)
 			{
-				while (true)
+				std::size_t part = (i == m_current) ? m_remaining : SizeFrom(i, std::index_sequence_for<Enums...>())(*this);
+
+				if (part == UnknownSize)
 				{
-					object = clause.m_enumerator.NextObject();
+					return UnknownSize;
 				}
+
+				size += part;
 			}
-			catch (EnumeratorEndException&)
-			{
-				return object;
-			}
+
+			return size;
 		}
 
-		Type Last() const
+		template <typename Enum>
+		ConcatEnumerator<Enums..., Enum> Append(const Enum& source) const
 		{
-			return Last([]() { return true; });
+			return ConcatEnumerator<Enums..., Enum>(std::tuple_cat(m_sources, std::make_tuple(source)), m_current, m_remaining);
 		}
 
-		Type LastOrDefault(std::function<bool(Type)> predicate) const
+		const Sources& Parts() const
 		{
-			try
-			{
-				return Last(predicate);
-			}
-			catch (EnumeratorEndException&)
+			return m_sources;
+		}
+
+	private:
+		ConcatEnumerator(Sources sources, std::size_t current, std::size_t remaining) :
+			m_sources(sources), m_current(current), m_remaining(remaining)
+		{
+
+		}
+
+		template <std::size_t... Is>
+		static auto NextFrom(std::size_t index, std::index_sequence<Is...>) -> value_type (*)(ConcatEnumerator&)
+		{
+			static value_type (* const table[])(ConcatEnumerator&) = { [](ConcatEnumerator& en) -> value_type
 			{
-				return Type();
-			}
+				return std::get<Is>(en.m_sources).NextObject();
+			}... };
+
+			return table[index];
 		}
 
-		Type LastOrDefault() const
+		template <std::size_t... Is>
+		static auto SizeFrom(std::size_t index, std::index_sequence<Is...>) -> std::size_t (*)(const ConcatEnumerator&)
 		{
-			return LastOrDefault([]() { return true; });
+			static std::size_t (* const table[])(const ConcatEnumerator&) = { [](const ConcatEnumerator& en) -> std::size_t
+			{
+				return SizeOf(std::get<Is>(en.m_sources));
+			}... };
+
+			return table[index];
 		}
 
-		// Concat
-		template <typename Enum2>
-		LinqObject<Enumerator<Type, std::pair<bool, std::pair<Enum, Enum2>>>> Concat(LinqObject<Enum2> rhs) const
+		Sources m_sources;
+		std::size_t m_current;
+		std::size_t m_remaining;
+	};
+
+	// Concat Range Enumerator (flat cursor over a run-time list of sources of one type)
+	template <typename Enum>
+	class ConcatRangeEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		ConcatRangeEnumerator(std::vector<Enum> sources) :
+			m_sources(sources), m_current(0), m_remaining(m_sources.empty() ? 0 : SizeOf(m_sources.front()))
 		{
-			using DataType = std::pair<bool, std::pair<Enum, Enum2>>;
 
-			return Enumerator<Type, DataType>([=](DataType& pair) -> Type
+		}
+
+		value_type NextObject()
+		{
+			while (m_current < m_sources.size())
 			{
-				if (pair.first)
+				if (m_remaining != 0)
 				{
-					return pair.second.second.NextObject();
-				}
+					try
+					{
+						value_type object = m_sources[m_current].NextObject();
 
-				try
-				{
-					return pair.second.first.NextObject();
+						if (m_remaining != UnknownSize)
+						{
+							--m_remaining;
+						}
+
+						return object;
+					}
+					catch (EnumeratorEndException&)
+					{
+
+					}
 				}
-				catch (EnumeratorEndException&)
+
+				if (++m_current < m_sources.size())
 				{
-					pair.first = true;
-					return pair.second.second.NextObject();
+					m_remaining = SizeOf(m_sources[m_current]);
 				}
-			}, std::make_pair(false, std::make_pair(m_enumerator, rhs.m_enumerator)));
+			}
+
+			throw EnumeratorEndException();
 		}
 
-		// Export to container
-		template <typename Container, typename Func>
-		Container ToContainer(Func func) const
+		std::size_t Size() const
 		{
-			Container container;
+			std::size_t size = 0;
 
-			try
+			for (std::size_t i = m_current; i < m_sources.size(); ++i)
 			{
-				auto en = m_enumerator;
+				std::size_t part = (i == m_current) ? m_remaining : SizeOf(m_sources[i]);
 
-				while (true)
+				if (part == UnknownSize)
 				{
-					func(container, en.NextObject());
+					return UnknownSize;
 				}
+
+				size += part;
 			}
-			catch (EnumeratorEndException&)
+
+			return size;
+		}
+
+		const std::vector<Enum>& Sources() const
+		{
+			return m_sources;
+		}
+
+	private:
+		std::vector<Enum> m_sources;
+		std::size_t m_current;
+		std::size_t m_remaining;
+	};
+
+	// SelectMany Enumerator (flat cursor over the sequences produced for each source object)
+	// The inner sequence may refer to the outer object, so the outer object is kept on the heap and
+	// shared by copies: a copied cursor keeps walking the same inner sequence without rebuilding it.
+	template <typename Enum, typename Func>
+	class SelectManyEnumerator
+	{
+		using outer_type = typename Enum::value_type;
+		using inner_type = decltype(std::declval<Func&>()(std::declval<outer_type&>()).m_enumerator);
+
+	public:
+		using value_type = typename inner_type::value_type;
+
+		SelectManyEnumerator(Enum source, Func transform) :
+			m_source(source), m_transform(transform), m_remaining(0)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			while (true)
 			{
+				if (m_inner)
+				{
+					if (m_remaining != 0)
+					{
+						try
+						{
+							value_type object = m_inner->NextObject();
+
+							if (m_remaining != UnknownSize)
+							{
+								--m_remaining;
+							}
 
+							return object;
+						}
+						catch (EnumeratorEndException&)
+						{
+
+						}
+					}
+
+					m_inner.reset();
+				}
+
+				NextOuter();
+				m_inner.emplace(m_transform(*m_outer).m_enumerator);
+				m_remaining = SizeOf(*m_inner);
 			}
+		}
 
-			return container;
+		const Enum& Source() const
+		{
+			return m_source;
 		}
 
-		// Export methods
-		std::vector<Type> ToVector() const
+	private:
+		// Each outer object gets storage of its own and is never written again, so a copy walking an
+		// inner sequence over it stays valid whichever thread advances the other cursor.
+		void NextOuter()
 		{
-			return ToContainer<std::vector<Type>>([](std::vector<Type>& container, const Type& value)
-			{
-				container.emplace_back(value);
-			});
+			m_outer = std::make_shared<outer_type>(m_source.NextObject());
 		}
 
-		std::list<Type> ToList() const
+		Enum m_source;
+		Func m_transform;
+		std::shared_ptr<outer_type> m_outer;
+		std::optional<inner_type> m_inner;
+		std::size_t m_remaining;
+	};
+
+	// Zip Enumerator (lockstep over several sources)
+	template <typename Func, typename... Enums>
+	class ZipEnumerator
+	{
+	public:
+		using value_type = typename std::decay<decltype(std::declval<Func&>()(std::declval<typename Enums::value_type>()...))>::type;
+
+		ZipEnumerator(Func transform, Enums... sources) :
+			m_transform(transform), m_sources(sources...)
 		{
-			return ToContainer<std::list<Type>>([](std::list<Type>& container, const Type& value)
-			{
-				container.emplace_back(value);
-			});
+
 		}
 
-		std::deque<Type> ToDeque() const
+		value_type NextObject()
 		{
-			return ToContainer<std::deque<Type>>([](std::deque<Type>& container, const Type& value)
+			return NextObject(std::index_sequence_for<Enums...>());
+		}
+
+		std::size_t Size() const
+		{
+			return Size(std::index_sequence_for<Enums...>());
+		}
+
+		// Contiguous sources are walked with one indexed loop the compiler can vectorize
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			if constexpr (std::conjunction<IsContiguousEnumerator<Enums>...>::value)
 			{
-				container.emplace_back(value);
-			});
+				ForEachIndexed(action, std::index_sequence_for<Enums...>());
+			}
+			else
+			{
+				try
+				{
+					while (true)
+					{
+						value_type object = NextObject();
+						action(object);
+					}
+				}
+				catch (EnumeratorEndException&)
+				{
+
+				}
+			}
 		}
 
-		std::set<Type> ToSet() const
+		const std::tuple<Enums...>& Sources() const
+		{
+			return m_sources;
+		}
+
+	private:
+		template <std::size_t... Is>
+		std::size_t Size(std::index_sequence<Is...>) const
 		{
-			return ToContainer<std::set<Type>>([](std::set<Type>& container, const Type& value)
+			std::size_t sizes[] = { SizeOf(std::get<Is>(m_sources))... };
+			std::size_t size = UnknownSize;
+
+			for (std::size_t part : sizes)
 			{
-				container.insert(value);
-			});
+				if (part == UnknownSize)
+				{
+					return UnknownSize;
+				}
+
+				size = std::min(size, part);
+			}
+
+			return size;
 		}
-	};
 
-	// From
-	template <typename Type, typename Iter>
-	LinqObject<Enumerator<Type, Iter>> From(Iter begin, Iter end)
-	{
-		return Enumerator<Type, Iter>([=](Iter& iter)
+		template <std::size_t... Is>
+		value_type NextObject(std::index_sequence<Is...>)
 		{
-			return (iter == end) ? throw EnumeratorEndException() : *(iter++);
-		}, begin);
-	}
+			// Braced initialization pulls the sources from left to right
+			std::tuple<typename Enums::value_type...> objects{ std::get<Is>(m_sources).NextObject()... };
+			return m_transform(std::get<Is>(objects)...);
+		}
 
-	template <typename Type, typename Iter>
-	LinqObject<Enumerator<Type, std::pair<Iter, int>>> From(Iter begin, int length)
-	{
-		return Enumerator<Type, std::pair<Iter, int>>([=](std::pair<Iter, int>& pair)
+		template <typename Action, std::size_t... Is>
+		void ForEachIndexed(Action& action, std::index_sequence<Is...>)
 		{
-			return (pair.second++ == length) ? throw EnumeratorEndException() : *(pair.first++);
-		}, std::make_pair(begin, 0));
-	}
+			std::size_t size = Size();
+			auto data = std::make_tuple(std::get<Is>(m_sources).Data()...);
 
-	template <typename Type, int N>
-	auto From(Type (&array)[N])
-		-> decltype(From<Type>(array, array + N))
-	{
-		return From<Type>(array, array + N);
-	}
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				value_type object = m_transform(std::get<Is>(data)[i]...);
+				action(object);
+			}
 
-	template <template <class> class Container, class Type>
-	auto From(const Container<Type>& container)
-		-> decltype(From<Type>(std::begin(container), std::end(container)))
-	{
-		return From<Type>(std::begin(container), std::end(container));
-	}
+			int advanced[] = { (std::get<Is>(m_sources).Advance(size), 0)... };
+			(void)advanced;
+		}
 
-	// For std::list, std::vector, std::dequeue
-	template<template<class, class> class V, typename T, typename U>
-	auto From(const V<T, U>& container)
-		-> decltype(From<T>(std::begin(container), std::end(container)))
-	{
-		return From<T>(std::begin(container), std::end(container));
-	}
+		Func m_transform;
+		std::tuple<Enums...> m_sources;
+	};
 
-	// For std::set
-	template <template <class, class, class> class V, typename T, typename S, typename U>
-	auto From(const V<T, S, U>& container)
-		-> decltype(From<T>(std::begin(container), std::end(container)))
+	// Set Operation
+	enum class SetOperation
 	{
-		return From<T>(std::begin(container), std::end(container));
-	}
+		Union,
+		Intersect,
+		Except
+	};
 
-	// For std::map
-	template <template <class, class, class, class> class V, typename K, typename T, typename S, typename U>
-	auto From(const V<K, T, S, U>& container)
-		-> decltype(From<std::pair<K, T>>(std::begin(container), std::end(container)))
+	// Set Operation Enumerator (distinct objects in the order of the first source, then the second for Union)
+	// Intersect and Except hash the smaller source when both sizes are known, the second one otherwise;
+	// Union streams both and remembers what it returned. Each source is enumerated once: when the first
+	// one is hashed, its distinct objects are also kept in order and the survivors are replayed from there.
+	template <typename Enum, typename Enum2, SetOperation Operation>
+	class SetOperationEnumerator
 	{
-		return From<std::pair<K, T>>(std::begin(container), std::end(container));
-	}
+	public:
+		using value_type = typename Enum::value_type;
 
-	// For std::array
-	template <template <class, size_t> class V, typename T, size_t L>
-	auto From(const V<T, L>& container)
-		-> decltype(From<T>(std::begin(container), std::end(container)))
-	{
-		return From<T>(std::begin(container), std::end(container));
-	}
+		SetOperationEnumerator(Enum first, Enum2 second) :
+			m_first(first), m_second(second), m_position(0), m_isPrepared(Operation == SetOperation::Union), m_emitOnErase(false), m_isFirstEnded(false)
+		{
 
-	// Repeat
-	template <typename Type>
-	LinqObject<Enumerator<Type, int>> Repeat(Type value, int count)
-	{
-		return Enumerator<Type, int>([=](int& index)
+		}
+
+		value_type NextObject()
 		{
-			return (index++ >= count) ? throw EnumeratorEndException() : value;
-		}, 0);
-	}
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
 
-	// Range
-	template <typename Type>
-	LinqObject<Enumerator<Type, std::pair<bool, Type>>> Range(Type begin, Type end, Type step)
-	{
-		return Enumerator<Type, std::pair<bool, Type>>([=](std::pair<bool, Type>& pair)
+		std::optional<value_type> TryNextObject()
 		{
-			if (!(pair.second < end))
+			if (!m_isPrepared)
+			{
+				Prepare();
+			}
+
+			if (m_position < m_order.size())
+			{
+				return m_order[m_position++];
+			}
+
+			while (!m_isFirstEnded)
+			{
+				std::optional<value_type> object = CppLinq::TryNextObject(m_first);
+
+				if (!object)
+				{
+					m_isFirstEnded = true;
+					break;
+				}
+
+				if (m_emitOnErase ? m_objects.erase(*object) > 0 : m_objects.insert(*object).second)
+				{
+					return object;
+				}
+			}
+
+			if constexpr (Operation == SetOperation::Union)
 			{
-				throw EnumeratorEndException();
+				while (std::optional<value_type> object = CppLinq::TryNextObject(m_second))
+				{
+					if (m_objects.insert(*object).second)
+					{
+						return object;
+					}
+				}
 			}
 
-			if (!pair.first)
+			return std::nullopt;
+		}
+
+		const Enum& First() const
+		{
+			return m_first;
+		}
+
+		const Enum2& Second() const
+		{
+			return m_second;
+		}
+
+		// Objects held by the lookup set and the ordered survivors
+		std::size_t Buffered() const
+		{
+			return m_objects.size() + m_order.size();
+		}
+
+	private:
+		void Prepare()
+		{
+			std::size_t firstSize = SizeOf(m_first);
+			std::size_t secondSize = SizeOf(m_second);
+
+			if (firstSize != UnknownSize && secondSize != UnknownSize && firstSize < secondSize)
 			{
-				pair.frist = true;
+				// Candidates are the distinct objects of the first source in order; the second one only
+				// strikes them off (Except) or marks them (Intersect)
+				LookupSet<value_type> candidates;
+
+				ForEachRemaining(m_first, [&](value_type& object)
+				{
+					if (candidates.insert(object).second)
+					{
+						m_order.push_back(object);
+					}
+				});
+
+				auto second = m_second;
+
+				ForEachRemaining(second, [&](value_type& object)
+				{
+					if (Operation == SetOperation::Intersect)
+					{
+						if (candidates.erase(object) > 0)
+						{
+							m_objects.insert(object);
+						}
+					}
+					else
+					{
+						candidates.erase(object);
+					}
+				});
+
+				const LookupSet<value_type>& survivors = (Operation == SetOperation::Intersect) ? m_objects : candidates;
+
+				m_order.erase(std::remove_if(m_order.begin(), m_order.end(), [&](const value_type& object)
+				{
+					return survivors.find(object) == survivors.end();
+				}), m_order.end());
+
+				m_objects.clear();
+				m_isFirstEnded = true;
 			}
 			else
 			{
-				pair.second += step;
+				auto second = m_second;
+
+				ForEachRemaining(second, [&](value_type& object)
+				{
+					m_objects.insert(object);
+				});
+
+				m_emitOnErase = (Operation == SetOperation::Intersect);
 			}
 
-			return pair.second;
-		}, std::make_pair(false, begin));
+			m_isPrepared = true;
+		}
+
+		Enum m_first;
+		Enum2 m_second;
+		LookupSet<value_type> m_objects;
+		std::vector<value_type> m_order;
+		std::size_t m_position;
+		bool m_isPrepared;
+		bool m_emitOnErase;
+		bool m_isFirstEnded;
+	};
+
+	// Merge Enumerator (set operation over two sorted sources in a single linear pass)
+	// Objects come out sorted and without duplicates.
+	template <typename Enum, typename Enum2, SetOperation Operation>
+	class MergeEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		MergeEnumerator(Enum first, Enum2 second) :
+			m_first(first), m_second(second), m_isFirstEnded(false), m_isSecondEnded(false)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			while (true)
+			{
+				Fill(m_first, m_firstObject, m_isFirstEnded);
+				Fill(m_second, m_secondObject, m_isSecondEnded);
+
+				std::optional<value_type> object;
+
+				if (m_firstObject && m_secondObject)
+				{
+					if (*m_firstObject < *m_secondObject)
+					{
+						if (Operation != SetOperation::Intersect)
+						{
+							object = m_firstObject;
+						}
+
+						m_firstObject.reset();
+					}
+					else if (*m_secondObject < *m_firstObject)
+					{
+						if (Operation == SetOperation::Union)
+						{
+							object = m_secondObject;
+						}
+
+						m_secondObject.reset();
+					}
+					else
+					{
+						// Equal objects: Except drops the first one and keeps the second to strike off its duplicates
+						if (Operation != SetOperation::Except)
+						{
+							object = m_firstObject;
+							m_secondObject.reset();
+						}
+
+						m_firstObject.reset();
+					}
+				}
+				else if (m_firstObject && Operation != SetOperation::Intersect)
+				{
+					object.swap(m_firstObject);
+				}
+				else if (m_secondObject && Operation == SetOperation::Union)
+				{
+					object.swap(m_secondObject);
+				}
+				else
+				{
+					return std::nullopt;
+				}
+
+				if (object && (!m_lastObject || *m_lastObject < *object))
+				{
+					m_lastObject = object;
+					return object;
+				}
+			}
+		}
+
+		const Enum& First() const
+		{
+			return m_first;
+		}
+
+		const Enum2& Second() const
+		{
+			return m_second;
+		}
+
+	private:
+		template <typename Source>
+		static void Fill(Source& source, std::optional<value_type>& object, bool& isEnded)
+		{
+			if (!object && !isEnded)
+			{
+				object = CppLinq::TryNextObject(source);
+				isEnded = !object;
+			}
+		}
+
+		Enum m_first;
+		Enum2 m_second;
+		std::optional<value_type> m_firstObject;
+		std::optional<value_type> m_secondObject;
+		std::optional<value_type> m_lastObject;
+		bool m_isFirstEnded;
+		bool m_isSecondEnded;
+	};
+
+	template <typename Enum, typename Enum2, SetOperation Operation>
+	struct IsSortedEnumerator<MergeEnumerator<Enum, Enum2, Operation>> : std::true_type { };
+
+	// Sorted Enumerator (a source whose objects are known to be in ascending order)
+	template <typename Enum>
+	class SortedEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		SortedEnumerator(Enum source) :
+			m_source(source)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			return m_source.NextObject();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			return CppLinq::TryNextObject(m_source);
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			CppLinq::ForEachRemaining(m_source, action);
+		}
+
+		std::size_t Size() const
+		{
+			return SizeOf(m_source);
+		}
+
+		// Objects left to enumerate (contiguous sources only)
+		auto Data() const
+		{
+			return m_source.Data();
+		}
+
+		void Advance(std::size_t count)
+		{
+			m_source.Advance(count);
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+	private:
+		Enum m_source;
+	};
+
+	template <typename Enum>
+	struct IsSortedEnumerator<SortedEnumerator<Enum>> : std::true_type { };
+
+	template <typename Enum>
+	struct IsContiguousEnumerator<SortedEnumerator<Enum>> : IsContiguousEnumerator<Enum> { };
+
+	// Take Enumerator (at most count objects of the source)
+	template <typename Enum>
+	class TakeEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		TakeEnumerator(Enum source, std::size_t count) :
+			m_source(source), m_count(count)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			if (m_count == 0)
+			{
+				return std::nullopt;
+			}
+
+			std::optional<value_type> object = CppLinq::TryNextObject(m_source);
+			m_count = object ? m_count - 1 : 0;
+
+			return object;
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			while (std::optional<value_type> object = TryNextObject())
+			{
+				action(*object);
+			}
+		}
+
+		std::size_t Size() const
+		{
+			std::size_t size = SizeOf(m_source);
+			return (size == UnknownSize) ? UnknownSize : std::min(size, m_count);
+		}
+
+		std::size_t Count() const
+		{
+			return m_count;
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+	private:
+		Enum m_source;
+		std::size_t m_count;
+	};
+
+	template <typename Enum>
+	struct IsSortedEnumerator<TakeEnumerator<Enum>> : IsSortedEnumerator<Enum> { };
+
+	// Skip Enumerator (the source without its first count objects, dropped on the first pull)
+	template <typename Enum>
+	class SkipEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		SkipEnumerator(Enum source, std::size_t count) :
+			m_source(source), m_count(count)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			return SkipObjects() ? CppLinq::TryNextObject(m_source) : std::nullopt;
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			if (SkipObjects())
+			{
+				CppLinq::ForEachRemaining(m_source, action);
+			}
+		}
+
+		std::size_t Size() const
+		{
+			std::size_t size = SizeOf(m_source);
+			return (size == UnknownSize) ? UnknownSize : size - std::min(size, m_count);
+		}
+
+		std::size_t Count() const
+		{
+			return m_count;
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+	private:
+		// Drops the objects left to skip; false when the source ended on the way
+		bool SkipObjects()
+		{
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				std::size_t count = std::min(m_count, m_source.Size());
+				m_source.Advance(count);
+				m_count -= count;
+			}
+			else
+			{
+				for (; m_count > 0; --m_count)
+				{
+					if (!CppLinq::TryNextObject(m_source))
+					{
+						m_count = 0;
+						return false;
+					}
+				}
+			}
+
+			return true;
+		}
+
+		Enum m_source;
+		std::size_t m_count;
+	};
+
+	template <typename Enum>
+	struct IsSortedEnumerator<SkipEnumerator<Enum>> : IsSortedEnumerator<Enum> { };
+
+	// Adjacent Distinct Enumerator (Distinct over a sorted source: equal objects are neighbours)
+	template <typename Enum>
+	class AdjacentDistinctEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		AdjacentDistinctEnumerator(Enum source) :
+			m_source(source)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			while (std::optional<value_type> object = CppLinq::TryNextObject(m_source))
+			{
+				if (!m_lastObject || *m_lastObject < *object)
+				{
+					m_lastObject = object;
+					return object;
+				}
+			}
+
+			return std::nullopt;
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+	private:
+		Enum m_source;
+		std::optional<value_type> m_lastObject;
+	};
+
+	template <typename Enum>
+	struct IsSortedEnumerator<AdjacentDistinctEnumerator<Enum>> : std::true_type { };
+
+	// Bound Enumerator (the objects of a sorted source from the first one not less than value;
+	// with isEqualRange, only the objects equivalent to value). Contiguous sources are binary searched.
+	template <typename Enum>
+	class BoundEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		BoundEnumerator(Enum source, const value_type& value, bool isEqualRange) :
+			m_source(source), m_value(value), m_isEqualRange(isEqualRange), m_isPrepared(false), m_count(UnknownSize)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			if (!m_isPrepared)
+			{
+				Prepare();
+			}
+
+			std::optional<value_type> object;
+
+			if (m_pendingObject)
+			{
+				object.swap(m_pendingObject);
+			}
+			else if (m_count == 0)
+			{
+				return std::nullopt;
+			}
+			else if (m_count != UnknownSize)
+			{
+				--m_count;
+				object = CppLinq::TryNextObject(m_source);
+			}
+			else
+			{
+				object = CppLinq::TryNextObject(m_source);
+
+				if (!object || (m_isEqualRange && m_value < *object))
+				{
+					m_count = 0;
+					return std::nullopt;
+				}
+			}
+
+			return object;
+		}
+
+		std::size_t Size() const
+		{
+			return (m_isPrepared && m_count != UnknownSize) ? m_count + (m_pendingObject ? 1 : 0) : UnknownSize;
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+		const value_type& Value() const
+		{
+			return m_value;
+		}
+
+		bool IsEqualRange() const
+		{
+			return m_isEqualRange;
+		}
+
+	private:
+		void Prepare()
+		{
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				const value_type* begin = m_source.Data();
+				const value_type* end = begin + m_source.Size();
+				const value_type* lower = std::lower_bound(begin, end, m_value);
+				const value_type* upper = m_isEqualRange ? std::upper_bound(lower, end, m_value) : end;
+
+				m_source.Advance(static_cast<std::size_t>(lower - begin));
+				m_count = static_cast<std::size_t>(upper - lower);
+			}
+			else
+			{
+				m_count = 0;
+
+				while (std::optional<value_type> object = CppLinq::TryNextObject(m_source))
+				{
+					if (!(*object < m_value))
+					{
+						if (!(m_isEqualRange && m_value < *object))
+						{
+							m_pendingObject = object;
+							m_count = UnknownSize;
+						}
+
+						break;
+					}
+				}
+			}
+
+			m_isPrepared = true;
+		}
+
+		Enum m_source;
+		value_type m_value;
+		bool m_isEqualRange;
+		bool m_isPrepared;
+		std::size_t m_count;
+		std::optional<value_type> m_pendingObject;
+	};
+
+	template <typename Enum>
+	struct IsSortedEnumerator<BoundEnumerator<Enum>> : std::true_type { };
+
+	// Chunk Enumerator (blocks of up to size objects)
+	// Blocks of a contiguous source are spans viewing the source directly. Blocks of any other source
+	// are spans viewing one buffer the enumerator reuses, so such a block is only valid until the next
+	// block is pulled; copy its objects out to keep them.
+	template <typename Enum>
+	class ChunkEnumerator
+	{
+		using object_type = typename Enum::value_type;
+
+	public:
+		using value_type = Span<const object_type>;
+
+		ChunkEnumerator(Enum source, std::size_t size) :
+			m_source(source), m_size(std::max<std::size_t>(size, 1))
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				std::size_t count = std::min(m_size, m_source.Size());
+				const object_type* data = m_source.Data();
+
+				if (count == 0)
+				{
+					throw EnumeratorEndException();
+				}
+
+				m_source.Advance(count);
+
+				return value_type(data, count);
+			}
+			else
+			{
+				m_buffer.clear();
+				m_buffer.reserve(m_size);
+
+				try
+				{
+					while (m_buffer.size() < m_size)
+					{
+						m_buffer.emplace_back(m_source.NextObject());
+					}
+				}
+				catch (EnumeratorEndException&)
+				{
+
+				}
+
+				if (m_buffer.empty())
+				{
+					throw EnumeratorEndException();
+				}
+
+				return value_type(m_buffer.data(), m_buffer.size());
+			}
+		}
+
+		std::size_t Size() const
+		{
+			std::size_t size = SizeOf(m_source);
+			return (size == UnknownSize) ? size : (size + m_size - 1) / m_size;
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				while (m_source.Size() != 0)
+				{
+					value_type batch = NextObject();
+					action(batch);
+				}
+			}
+			else
+			{
+				m_buffer.clear();
+				m_buffer.reserve(m_size);
+
+				CppLinq::ForEachRemaining(m_source, [&](object_type& object)
+				{
+					m_buffer.emplace_back(object);
+
+					if (m_buffer.size() == m_size)
+					{
+						value_type batch(m_buffer.data(), m_buffer.size());
+						action(batch);
+						m_buffer.clear();
+					}
+				});
+
+				if (!m_buffer.empty())
+				{
+					value_type batch(m_buffer.data(), m_buffer.size());
+					action(batch);
+					m_buffer.clear();
+				}
+			}
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+		std::size_t ChunkSize() const
+		{
+			return m_size;
+		}
+
+	private:
+		Enum m_source;
+		std::size_t m_size;
+		std::vector<object_type> m_buffer;
+	};
+
+	// Scan Enumerator (running aggregate: f(seed, x0), f(f(seed, x0), x1), ...)
+	template <typename Enum, typename Ret, typename Func>
+	class ScanEnumerator
+	{
+	public:
+		using value_type = Ret;
+
+		ScanEnumerator(Enum source, Ret seed, Func accumulate) :
+			m_source(source), m_accumulator(seed), m_accumulate(accumulate)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			typename Enum::value_type object = m_source.NextObject();
+			m_accumulator = m_accumulate(m_accumulator, object);
+
+			return m_accumulator;
+		}
+
+		std::size_t Size() const
+		{
+			return SizeOf(m_source);
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			CppLinq::ForEachRemaining(m_source, [&](typename Enum::value_type& object)
+			{
+				m_accumulator = m_accumulate(m_accumulator, object);
+
+				value_type result = m_accumulator;
+				action(result);
+			});
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+	private:
+		Enum m_source;
+		Ret m_accumulator;
+		Func m_accumulate;
+	};
+
+	// Memoize Enumerator (replays the objects of a single upstream pass)
+	// Copies share a buffer that is filled from the source on demand, so every enumeration after
+	// the first reads the buffer. Objects are handed out under a lock, in batches where possible.
+	template <typename Enum>
+	class MemoizeEnumerator
+	{
+		static constexpr std::size_t BatchSize = 64;
+
+		struct State
+		{
+			State(Enum enumerator) :
+				source(enumerator), isEnded(false)
+			{
+
+			}
+
+			std::mutex mutex;
+			Enum source;
+			std::deque<typename Enum::value_type> objects;
+			bool isEnded;
+		};
+
+		// Makes count objects past the current position available unless the source ends first (lock held)
+		void Fill(std::size_t count)
+		{
+			while (m_state->objects.size() < m_position + count && !m_state->isEnded)
+			{
+				std::optional<value_type> object = CppLinq::TryNextObject(m_state->source);
+
+				if (!object)
+				{
+					m_state->isEnded = true;
+					break;
+				}
+
+				m_state->objects.push_back(std::move(*object));
+			}
+		}
+
+	public:
+		using value_type = typename Enum::value_type;
+
+		MemoizeEnumerator(Enum source) :
+			m_state(std::make_shared<State>(source)), m_position(0)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			std::lock_guard<std::mutex> lock(m_state->mutex);
+			Fill(1);
+
+			return (m_position < m_state->objects.size()) ? std::optional<value_type>(m_state->objects[m_position++]) : std::nullopt;
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			std::vector<value_type> batch;
+
+			do
+			{
+				batch.clear();
+
+				{
+					std::lock_guard<std::mutex> lock(m_state->mutex);
+					Fill(BatchSize);
+
+					for (; batch.size() < BatchSize && m_position < m_state->objects.size(); ++m_position)
+					{
+						batch.push_back(m_state->objects[m_position]);
+					}
+				}
+
+				for (value_type& object : batch)
+				{
+					action(object);
+				}
+			} while (!batch.empty());
+		}
+
+		std::size_t Size() const
+		{
+			std::lock_guard<std::mutex> lock(m_state->mutex);
+			std::size_t buffered = m_state->objects.size() - m_position;
+
+			if (m_state->isEnded)
+			{
+				return buffered;
+			}
+
+			std::size_t size = SizeOf(m_state->source);
+			return (size == UnknownSize) ? size : size + buffered;
+		}
+
+		// Objects held by the shared buffer
+		std::size_t Buffered() const
+		{
+			std::lock_guard<std::mutex> lock(m_state->mutex);
+			return m_state->objects.size();
+		}
+
+		const Enum& Source() const
+		{
+			return m_state->source;
+		}
+
+	private:
+		std::shared_ptr<State> m_state;
+		std::size_t m_position;
+	};
+
+	template <typename Enum>
+	struct IsSortedEnumerator<MemoizeEnumerator<Enum>> : IsSortedEnumerator<Enum> { };
+
+	// Window Enumerator (one aggregate per full sliding window of size objects)
+	// Keeps the last size objects in a ring buffer and updates the aggregator with the object
+	// entering and the object leaving the window, so each result costs amortized O(1).
+	template <typename Enum, typename Aggregator>
+	class WindowEnumerator
+	{
+		using object_type = typename Enum::value_type;
+
+	public:
+		using value_type = typename std::decay<decltype(std::declval<const Aggregator&>().Result())>::type;
+
+		WindowEnumerator(Enum source, std::size_t size, Aggregator aggregator) :
+			m_source(source), m_aggregator(aggregator), m_size(std::max<std::size_t>(size, 1)), m_head(0)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			while (true)
+			{
+				object_type object = m_source.NextObject();
+
+				if (m_window.size() == m_size)
+				{
+					m_aggregator.Pop(m_window[m_head]);
+					m_window[m_head] = object;
+					m_head = (m_head + 1) % m_size;
+				}
+				else
+				{
+					m_window.reserve(m_size);
+					m_window.emplace_back(object);
+				}
+
+				m_aggregator.Push(object);
+
+				if (m_window.size() == m_size)
+				{
+					return m_aggregator.Result();
+				}
+			}
+		}
+
+		std::size_t Size() const
+		{
+			std::size_t size = SizeOf(m_source);
+			std::size_t missing = m_size - m_window.size();
+
+			if (size == UnknownSize || missing == 0)
+			{
+				return size;
+			}
+
+			return (size < missing) ? 0 : size - missing + 1;
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+		std::size_t WindowSize() const
+		{
+			return m_size;
+		}
+
+	private:
+		Enum m_source;
+		Aggregator m_aggregator;
+		std::size_t m_size;
+		std::vector<object_type> m_window;
+		std::size_t m_head;
+	};
+
+	// Window Sum
+	template <typename Type>
+	class WindowSum
+	{
+	public:
+		void Push(const Type& object)
+		{
+			m_sum += object;
+		}
+
+		void Pop(const Type& object)
+		{
+			m_sum -= object;
+		}
+
+		Type Result() const
+		{
+			return m_sum;
+		}
+
+	private:
+		Type m_sum = Type();
+	};
+
+	// Window Average
+	template <typename Type>
+	class WindowAverage
+	{
+	public:
+		void Push(const Type& object)
+		{
+			m_sum += object;
+			m_count++;
+		}
+
+		void Pop(const Type& object)
+		{
+			m_sum -= object;
+			m_count--;
+		}
+
+		Type Result() const
+		{
+			return m_sum / static_cast<Type>(m_count);
+		}
+
+	private:
+		Type m_sum = Type();
+		std::size_t m_count = 0;
+	};
+
+	// Window Extremum (monotonic deque: candidates ordered from the best one down)
+	template <typename Type, typename Compare>
+	class WindowExtremum
+	{
+	public:
+		void Push(const Type& object)
+		{
+			while (!m_candidates.empty() && Compare()(object, m_candidates.back().first))
+			{
+				m_candidates.pop_back();
+			}
+
+			m_candidates.emplace_back(object, m_pushed++);
+		}
+
+		void Pop(const Type&)
+		{
+			if (m_candidates.front().second == m_popped++)
+			{
+				m_candidates.pop_front();
+			}
+		}
+
+		Type Result() const
+		{
+			return m_candidates.front().first;
+		}
+
+	private:
+		std::deque<std::pair<Type, std::size_t>> m_candidates;
+		std::size_t m_pushed = 0;
+		std::size_t m_popped = 0;
+	};
+
+	template <typename Type>
+	using WindowMin = WindowExtremum<Type, std::less<Type>>;
+
+	template <typename Type>
+	using WindowMax = WindowExtremum<Type, std::greater<Type>>;
+
+	// Aggregators for AggregateMany
+	// Push adds one object; PushBlock, when present, adds a contiguous block in a loop simple enough
+	// for the compiler to vectorize.
+	template <typename Aggregator, typename Type, typename = void>
+	struct HasPushBlock : std::false_type { };
+
+	template <typename Aggregator, typename Type>
+	struct HasPushBlock<Aggregator, Type, decltype(std::declval<Aggregator&>().PushBlock(std::declval<const Type*>(), std::size_t()))> : std::true_type { };
+
+	// Aggregate Sum
+	template <typename Type>
+	class AggregateSum
+	{
+	public:
+		void Push(const Type& object)
+		{
+			m_sum += object;
+		}
+
+		void PushBlock(const Type* objects, std::size_t size)
+		{
+			Type sum = Type();
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				sum += objects[i];
+			}
+
+			m_sum += sum;
+		}
+
+		Type Result() const
+		{
+			return m_sum;
+		}
+
+	private:
+		Type m_sum = Type();
+	};
+
+	// Aggregate Count
+	template <typename Type>
+	class AggregateCount
+	{
+	public:
+		void Push(const Type&)
+		{
+			m_count++;
+		}
+
+		void PushBlock(const Type*, std::size_t size)
+		{
+			m_count += size;
+		}
+
+		std::size_t Result() const
+		{
+			return m_count;
+		}
+
+	private:
+		std::size_t m_count = 0;
+	};
+
+	// Aggregate Average (Type() for an empty sequence, like Average)
+	template <typename Type>
+	class AggregateAverage
+	{
+		using Sum = typename WideType<Type>::type;
+
+	public:
+		void Push(const Type& object)
+		{
+			m_sum += static_cast<Sum>(object);
+			m_count++;
+		}
+
+		void PushBlock(const Type* objects, std::size_t size)
+		{
+			Sum sum = Sum();
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				sum += static_cast<Sum>(objects[i]);
+			}
+
+			m_sum += sum;
+			m_count += size;
+		}
+
+		Type Result() const
+		{
+			return (m_count == 0) ? Type() : static_cast<Type>(m_sum / static_cast<Sum>(m_count));
+		}
+
+	private:
+		Sum m_sum = Sum();
+		std::size_t m_count = 0;
+	};
+
+	// Aggregate Extremum (throws EnumeratorEndException for an empty sequence, like Min and Max)
+	template <typename Type, typename Compare>
+	class AggregateExtremum
+	{
+	public:
+		void Push(const Type& object)
+		{
+			if (!m_hasResult || Compare()(object, m_result))
+			{
+				m_result = object;
+				m_hasResult = true;
+			}
+		}
+
+		void PushBlock(const Type* objects, std::size_t size)
+		{
+			if (size == 0)
+			{
+				return;
+			}
+
+			Type result = m_hasResult ? m_result : objects[0];
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				result = Compare()(objects[i], result) ? objects[i] : result;
+			}
+
+			m_result = result;
+			m_hasResult = true;
+		}
+
+		Type Result() const
+		{
+			return m_hasResult ? m_result : throw EnumeratorEndException();
+		}
+
+	private:
+		Type m_result = Type();
+		bool m_hasResult = false;
+	};
+
+	template <typename Type>
+	using AggregateMin = AggregateExtremum<Type, std::less<Type>>;
+
+	template <typename Type>
+	using AggregateMax = AggregateExtremum<Type, std::greater<Type>>;
+
+	// Predicate conjunction used to fuse adjacent Where clauses
+	template <typename First, typename Second>
+	class AndPredicate
+	{
+	public:
+		AndPredicate(First first, Second second) :
+			m_first(first), m_second(second)
+		{
+
+		}
+
+		template <typename Type>
+		bool operator()(Type& object)
+		{
+			return m_first(object) && m_second(object);
+		}
+
+	private:
+		First m_first;
+		Second m_second;
+	};
+
+	// Transform composition used to fuse adjacent Select clauses
+	template <typename First, typename Second>
+	class ComposedTransform
+	{
+	public:
+		ComposedTransform(First first, Second second) :
+			m_first(first), m_second(second)
+		{
+
+		}
+
+		// The intermediate object is stored first, so the second transform receives an lvalue
+		// exactly as it does when the two Select clauses run as separate stages.
+		template <typename Type>
+		auto operator()(Type& object) -> decltype(std::declval<Second&>()(std::declval<typename std::decay<decltype(std::declval<First&>()(object))>::type&>()))
+		{
+			typename std::decay<decltype(m_first(object))>::type intermediate = m_first(object);
+			return m_second(intermediate);
+		}
+
+	private:
+		First m_first;
+		Second m_second;
+	};
+
+	// Query Rewriter
+	// Rewrite rules are chosen by the type of the stage a clause is applied to, so a query is
+	// restructured while it is composed and the terminal runs the rewritten pipeline.
+	template <typename Enum>
+	class QueryRewriterBase
+	{
+	public:
+		template <typename Func>
+		static WhereEnumerator<Enum, Func> Where(const Enum& source, Func predicate)
+		{
+			return WhereEnumerator<Enum, Func>(source, predicate);
+		}
+
+		template <typename Func>
+		static SelectEnumerator<Enum, Func> Select(const Enum& source, Func transform)
+		{
+			return SelectEnumerator<Enum, Func>(source, transform);
+		}
+
+		template <typename Enum2>
+		static ConcatEnumerator<Enum, Enum2> Concat(const Enum& source, const Enum2& rhs)
+		{
+			return ConcatEnumerator<Enum, Enum2>(source, rhs);
+		}
+
+		static std::size_t Count(const Enum& source)
+		{
+			std::size_t size = SizeOf(source);
+
+			if (size != UnknownSize)
+			{
+				return size;
+			}
+
+			auto en = source;
+			std::size_t count = 0;
+
+			ForEachRemaining(en, [&](typename Enum::value_type&)
+			{
+				count++;
+			});
+
+			return count;
+		}
+
+		static typename Enum::value_type First(const Enum& source)
+		{
+			auto en = source;
+			return en.NextObject();
+		}
+	};
+
+	template <typename Enum>
+	class QueryRewriter : public QueryRewriterBase<Enum>
+	{
+
+	};
+
+	// Where(a).Where(b) => Where(a && b)
+	template <typename Enum, typename Pred>
+	class QueryRewriter<WhereEnumerator<Enum, Pred>> : public QueryRewriterBase<WhereEnumerator<Enum, Pred>>
+	{
+	public:
+		template <typename Func>
+		static WhereEnumerator<Enum, AndPredicate<Pred, Func>> Where(const WhereEnumerator<Enum, Pred>& source, Func predicate)
+		{
+			return WhereEnumerator<Enum, AndPredicate<Pred, Func>>(source.Source(), AndPredicate<Pred, Func>(source.Predicate(), predicate));
+		}
+	};
+
+	// Select(f).Select(g) => Select(g(f)), Select(f).Count() => Count()
+	// (Select(f).Any() keeps f: Any() tests the projected objects, not whether any object exists)
+	template <typename Enum, typename Trans>
+	class QueryRewriter<SelectEnumerator<Enum, Trans>> : public QueryRewriterBase<SelectEnumerator<Enum, Trans>>
+	{
+	public:
+		template <typename Func>
+		static SelectEnumerator<Enum, ComposedTransform<Trans, Func>> Select(const SelectEnumerator<Enum, Trans>& source, Func transform)
+		{
+			return SelectEnumerator<Enum, ComposedTransform<Trans, Func>>(source.Source(), ComposedTransform<Trans, Func>(source.Transform(), transform));
+		}
+
+		static std::size_t Count(const SelectEnumerator<Enum, Trans>& source)
+		{
+			return QueryRewriter<Enum>::Count(source.Source());
+		}
+	};
+
+	// OrderBy(k).Where(p) => Where(p).OrderBy(k), OrderBy(k).First() => Min(k)
+	template <typename Enum, typename Trans>
+	class QueryRewriter<OrderByEnumerator<Enum, Trans>> : public QueryRewriterBase<OrderByEnumerator<Enum, Trans>>
+	{
+	public:
+		template <typename Func>
+		static auto Where(const OrderByEnumerator<Enum, Trans>& source, Func predicate)
+			-> OrderByEnumerator<decltype(QueryRewriter<Enum>::Where(source.Source(), predicate)), Trans>
+		{
+			return { QueryRewriter<Enum>::Where(source.Source(), predicate), source, predicate };
+		}
+
+		static typename Enum::value_type First(const OrderByEnumerator<Enum, Trans>& source)
+		{
+			return source.First();
+		}
+	};
+
+	// Concat(a, b).Concat(c) => Concat(a, b, c)
+	template <typename... Enums>
+	class QueryRewriter<ConcatEnumerator<Enums...>> : public QueryRewriterBase<ConcatEnumerator<Enums...>>
+	{
+	public:
+		template <typename Enum2>
+		static ConcatEnumerator<Enums..., Enum2> Concat(const ConcatEnumerator<Enums...>& source, const Enum2& rhs)
+		{
+			return source.Append(rhs);
+		}
+	};
+
+	// Reverse().Where(p) => Where(p).Reverse()
+	template <typename Enum>
+	class QueryRewriter<ReverseEnumerator<Enum>> : public QueryRewriterBase<ReverseEnumerator<Enum>>
+	{
+	public:
+		template <typename Func>
+		static auto Where(const ReverseEnumerator<Enum>& source, Func predicate)
+			-> ReverseEnumerator<decltype(QueryRewriter<Enum>::Where(source.Source(), predicate))>
+		{
+			return { QueryRewriter<Enum>::Where(source.Source(), predicate), source, predicate };
+		}
+	};
+
+	// Query Plan (operator tree returned by Explain)
+	struct QueryPlan
+	{
+		std::string name;
+		std::size_t cardinality = UnknownSize;
+		bool isUpperBound = false;
+		std::size_t memory = 0;
+		bool isPipelineBreaker = false;
+		std::vector<std::string> notes;
+		std::vector<QueryPlan> inputs;
+
+		std::string ToString() const
+		{
+			std::ostringstream stream;
+			stream << *this;
+
+			return stream.str();
+		}
+
+		friend std::ostream& operator<<(std::ostream& stream, const QueryPlan& plan)
+		{
+			plan.Print(stream, 0);
+			return stream;
+		}
+
+	private:
+		void Print(std::ostream& stream, std::size_t depth) const
+		{
+			std::string indent(depth * 2, ' ');
+
+			stream << indent << name;
+
+			if (cardinality != UnknownSize)
+			{
+				stream << " [" << (isUpperBound ? "at most " : "") << cardinality << " objects]";
+			}
+
+			if (isPipelineBreaker)
+			{
+				stream << " (pipeline breaker)";
+			}
+
+			if (memory == UnknownSize)
+			{
+				stream << " (buffers an unknown amount)";
+			}
+			else if (memory != 0)
+			{
+				stream << " (buffers ~" << memory << " bytes)";
+			}
+
+			stream << '\n';
+
+			for (const std::string& note : notes)
+			{
+				stream << indent << "  * " << note << '\n';
+			}
+
+			for (const QueryPlan& input : inputs)
+			{
+				input.Print(stream, depth + 1);
+			}
+		}
+	};
+
+	// Query Explainer
+	// Describes one kind of stage and recurses into its inputs; specialised per enumerator like
+	// QueryRewriter so Explain() reports the plan the rewrites actually produced.
+	template <typename Enum>
+	class QueryExplainer
+	{
+	public:
+		static QueryPlan Explain(const Enum& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "Enumerator";
+			plan.cardinality = SizeOf(enumerator);
+			plan.notes.push_back("custom stage; objects are pulled one at a time");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	QueryPlan ExplainQuery(const Enum& enumerator)
+	{
+		return QueryExplainer<Enum>::Explain(enumerator);
+	}
+
+	// Plan of a stage named name over one input, yielding SizeOf(enumerator) objects when known and
+	// otherwise at most as many objects as its input
+	template <typename Enum, typename Input>
+	QueryPlan ExplainStage(const char* name, const Enum& enumerator, const Input& input)
+	{
+		QueryPlan plan;
+
+		plan.name = name;
+		plan.cardinality = SizeOf(enumerator);
+		plan.inputs.push_back(ExplainQuery(input));
+
+		if (plan.cardinality == UnknownSize)
+		{
+			plan.cardinality = plan.inputs.front().cardinality;
+			plan.isUpperBound = (plan.cardinality != UnknownSize);
+		}
+
+		return plan;
+	}
+
+	// Memory taken by count objects of a given size, UnknownSize when the count is unknown
+	inline std::size_t BufferSize(std::size_t count, std::size_t objectSize)
+	{
+		return (count == UnknownSize) ? UnknownSize : count * objectSize;
+	}
+
+	// Query Profile (per-stage statistics collected by WithProfiling)
+	// Statistics add up over every enumeration of the profiled query; one query is profiled from one thread.
+	class QueryProfile
+	{
+		template <typename Enum>
+		friend class ProfileEnumerator;
+
+	public:
+		struct Stage
+		{
+			std::string name;
+			std::size_t objectsIn = 0;
+			std::size_t objectsOut = 0;
+			std::size_t peakBuffered = 0;
+			std::chrono::nanoseconds time = std::chrono::nanoseconds::zero();
+			std::chrono::nanoseconds selfTime = std::chrono::nanoseconds::zero();
+		};
+
+		// Stages from the source down; time includes the stages before, selfTime does not
+		std::vector<Stage> Stages() const
+		{
+			std::vector<Stage> stages = m_stages;
+
+			for (std::size_t i = 0; i < stages.size(); ++i)
+			{
+				stages[i].objectsIn = (i == 0) ? stages[i].objectsOut : stages[i - 1].objectsOut;
+				stages[i].selfTime = (i == 0) ? stages[i].time : std::max(stages[i].time - stages[i - 1].time, std::chrono::nanoseconds::zero());
+			}
+
+			return stages;
+		}
+
+		void Reset()
+		{
+			for (Stage& stage : m_stages)
+			{
+				stage = Stage{ stage.name };
+			}
+		}
+
+		friend std::ostream& operator<<(std::ostream& stream, const QueryProfile& profile)
+		{
+			for (const Stage& stage : profile.Stages())
+			{
+				stream << stage.name << ": " << stage.objectsIn << " in, " << stage.objectsOut << " out, " << stage.peakBuffered << " buffered, "
+					<< stage.time.count() << " ns (self " << stage.selfTime.count() << " ns)\n";
+			}
+
+			return stream;
+		}
+
+	private:
+		std::size_t AddStage(const char* name)
+		{
+			m_stages.push_back(Stage{ name });
+			return m_stages.size() - 1;
+		}
+
+		std::vector<Stage> m_stages;
+	};
+
+	template <typename Enum, typename = void>
+	struct HasBuffered : std::false_type { };
+
+	template <typename Enum>
+	struct HasBuffered<Enum, decltype(void(std::declval<const Enum&>().Buffered()))> : std::true_type { };
+
+	// Profile Enumerator (records the objects and the time of the stage it wraps)
+	// Only one pull in SampleInterval is timed, standing for the pulls since the previous timed one.
+	// Pushed objects are timed around the whole loop minus the time spent downstream, which is
+	// sampled the same way, so counting objects is exact while times are estimates.
+	template <typename Enum>
+	class ProfileEnumerator
+	{
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::size_t SampleInterval = 64;
+
+	public:
+		using value_type = typename Enum::value_type;
+
+		ProfileEnumerator(Enum source, QueryProfile& profile, const char* name) :
+			m_source(source), m_profile(&profile), m_stage(profile.AddStage(name)), m_pulls(0)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			std::size_t weight = Weight(m_pulls++);
+
+			if (weight == 0)
+			{
+				std::optional<value_type> object = CppLinq::TryNextObject(m_source);
+				Record(Clock::duration::zero(), object ? 1 : 0);
+
+				return object;
+			}
+
+			Clock::time_point start = Clock::now();
+			std::optional<value_type> object = CppLinq::TryNextObject(m_source);
+
+			Record((Clock::now() - start) * weight, object ? 1 : 0);
+
+			return object;
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			Clock::duration downstream = Clock::duration::zero();
+			std::size_t count = 0;
+			Clock::time_point start = Clock::now();
+
+			CppLinq::ForEachRemaining(m_source, [&](value_type& object)
+			{
+				std::size_t weight = Weight(count++);
+				SampleBuffered();
+
+				if (weight == 0)
+				{
+					action(object);
+					return;
+				}
+
+				Clock::time_point actionStart = Clock::now();
+				action(object);
+				downstream += (Clock::now() - actionStart) * weight;
+			});
+
+			Record(std::max(Clock::now() - start - downstream, Clock::duration::zero()), count);
+		}
+
+		std::size_t Size() const
+		{
+			return SizeOf(m_source);
+		}
+
+		QueryProfile& Profile() const
+		{
+			return *m_profile;
+		}
+
+		const Enum& Source() const
+		{
+			return m_source;
+		}
+
+	private:
+		// Number of objects the timing of the index-th one stands for, 0 when it is not timed
+		static std::size_t Weight(std::size_t index)
+		{
+			return (index % SampleInterval != 0) ? 0 : (index == 0) ? 1 : SampleInterval;
+		}
+
+		void Record(Clock::duration time, std::size_t count)
+		{
+			QueryProfile::Stage& stage = m_profile->m_stages[m_stage];
+
+			stage.objectsOut += count;
+			stage.time += std::chrono::duration_cast<std::chrono::nanoseconds>(time);
+
+			SampleBuffered();
+		}
+
+		void SampleBuffered()
+		{
+			if constexpr (HasBuffered<Enum>::value)
+			{
+				QueryProfile::Stage& stage = m_profile->m_stages[m_stage];
+				stage.peakBuffered = std::max(stage.peakBuffered, m_source.Buffered());
+			}
+		}
+
+		Enum m_source;
+		QueryProfile* m_profile;
+		std::size_t m_stage;
+		std::size_t m_pulls;
+	};
+
+	template <typename Enum>
+	struct IsSortedEnumerator<ProfileEnumerator<Enum>> : IsSortedEnumerator<Enum> { };
+
+	// Lookup (objects grouped by key, each group stored contiguously; keys keep their first-seen order)
+	// Built with a counting sort: one pass assigns groups and counts them, a second places the objects.
+	template <typename Key, typename Type>
+	class Lookup
+	{
+	public:
+		template <typename Func>
+		Lookup(const std::vector<Type>& objects, Func key) :
+			m_offsets(1, 0)
+		{
+			std::vector<std::size_t> groups;
+			groups.reserve(objects.size());
+
+			for (const Type& object : objects)
+			{
+				auto inserted = m_index.emplace(key(object), m_keys.size());
+
+				if (inserted.second)
+				{
+					m_keys.push_back(inserted.first->first);
+					m_offsets.push_back(0);
+				}
+
+				groups.push_back(inserted.first->second);
+				++m_offsets[inserted.first->second + 1];
+			}
+
+			std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+			std::vector<std::size_t> next(m_offsets.begin(), m_offsets.end() - 1);
+			std::vector<std::size_t> order(objects.size());
+
+			for (std::size_t i = 0; i < objects.size(); ++i)
+			{
+				order[next[groups[i]]++] = i;
+			}
+
+			m_objects.reserve(objects.size());
+
+			for (std::size_t i : order)
+			{
+				m_objects.push_back(objects[i]);
+			}
+		}
+
+		// Objects with key, in their original order (empty when there are none)
+		Span<const Type> operator[](const Key& key) const
+		{
+			auto group = m_index.find(key);
+
+			if (group == m_index.end())
+			{
+				return Span<const Type>(nullptr, 0);
+			}
+
+			return Span<const Type>(m_objects.data() + m_offsets[group->second], m_offsets[group->second + 1] - m_offsets[group->second]);
+		}
+
+		bool Contains(const Key& key) const
+		{
+			return m_index.find(key) != m_index.end();
+		}
+
+		const std::vector<Key>& Keys() const
+		{
+			return m_keys;
+		}
+
+		// Number of keys
+		std::size_t Size() const
+		{
+			return m_keys.size();
+		}
+
+	private:
+		LookupMap<Key, std::size_t> m_index;
+		std::vector<Key> m_keys;
+		std::vector<std::size_t> m_offsets;
+		std::vector<Type> m_objects;
+	};
+
+	template <typename Enum>
+	class ProfiledLinqObject;
+
+	template <typename Type, typename Container>
+	class BucketEnumerator;
+
+	// Linq Sentinel (end of a LinqIterator)
+	class LinqSentinel { };
+
+	// Linq Iterator (single-pass input iterator over a copy of a pipeline)
+	// The end is found through TryNextObject, and copies share the pipeline like stream iterators do.
+	template <typename Enum>
+	class LinqIterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type = typename Enum::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const value_type*;
+		using reference = const value_type&;
+
+		LinqIterator() = default;
+
+		explicit LinqIterator(const Enum& enumerator) :
+			m_enumerator(std::make_shared<Enum>(enumerator)), m_current(CppLinq::TryNextObject(*m_enumerator))
+		{
+
+		}
+
+		reference operator*() const
+		{
+			return *m_current;
+		}
+
+		pointer operator->() const
+		{
+			return std::addressof(*m_current);
+		}
+
+		LinqIterator& operator++()
+		{
+			m_current = CppLinq::TryNextObject(*m_enumerator);
+			return *this;
+		}
+
+		LinqIterator operator++(int)
+		{
+			LinqIterator result = *this;
+			++*this;
+			return result;
+		}
+
+		bool operator==(const LinqIterator& other) const
+		{
+			return !m_current == !other.m_current && (!m_current || m_enumerator == other.m_enumerator);
+		}
+
+		bool operator!=(const LinqIterator& other) const
+		{
+			return !(*this == other);
+		}
+
+		friend bool operator==(const LinqIterator& iter, LinqSentinel)
+		{
+			return !iter.m_current;
+		}
+
+		friend bool operator==(LinqSentinel, const LinqIterator& iter)
+		{
+			return !iter.m_current;
+		}
+
+		friend bool operator!=(const LinqIterator& iter, LinqSentinel)
+		{
+			return static_cast<bool>(iter.m_current);
+		}
+
+		friend bool operator!=(LinqSentinel, const LinqIterator& iter)
+		{
+			return static_cast<bool>(iter.m_current);
+		}
+
+	private:
+		std::shared_ptr<Enum> m_enumerator;
+		std::optional<value_type> m_current;
+	};
+
+	// Linq Object
+	template<typename Enum>
+	class LinqObject
+	{
+		using Type = typename Enum::value_type;
+
+		template <typename Func, typename Arg>
+		static auto GetReturnType(Func* func = nullptr, Arg* arg1 = nullptr)
+			-> decltype((*func)(*arg1));
+
+		template <typename Func, typename Arg1, typename Arg2>
+		static auto GetReturnType(Func* func = nullptr, Arg1* arg1 = nullptr, Arg2* arg2 = nullptr)
+			-> decltype((*func)(*arg1, *arg2));
+
+		// Select Internal
+		template <typename Ret>
+		LinqObject<Enumerator<Ret, std::pair<Enum, std::size_t>>> SelectInternal(std::function<Ret(Type, std::size_t)> transform) const
+		{
+			return Enumerator<Ret, std::pair<Enum, std::size_t>>([=](std::pair<Enum, std::size_t>& pair) -> std::optional<Ret>
+			{
+				std::optional<Type> object = CppLinq::TryNextObject(pair.first);
+				return object ? std::optional<Ret>(transform(*object, pair.second++)) : std::nullopt;
+			}, std::make_pair(m_enumerator, std::size_t(0)));
+		}
+
+		template <typename Func>
+		LinqObject<Enumerator<decltype(GetReturnType<Func, Type, std::size_t>()), std::pair<Enum, std::size_t>>> SelectInternal(Func transform) const
+		{
+			return SelectInternal<decltype(GetReturnType<Func, Type, std::size_t>())>(transform);
+		}
+
+		// Where Internal
+		LinqObject<Enumerator<Type, std::pair<Enum, std::size_t>>> WhereInternal(std::function<bool(Type, std::size_t)> predicate) const
+		{
+			return Enumerator<Type, std::pair<Enum, std::size_t>>([=](std::pair<Enum, std::size_t>& pair) -> std::optional<Type>
+			{
+				for (std::optional<Type> object = CppLinq::TryNextObject(pair.first); object; object = CppLinq::TryNextObject(pair.first))
+				{
+					if (predicate(*object, pair.second++))
+					{
+						return object;
+					}
+				}
+
+				return std::nullopt;
+			}, std::make_pair(m_enumerator, std::size_t(0)));
+		}
+
+		// Foreach Internal
+		void ForeachInternal(std::function<void(Type, std::size_t)> action) const
+		{
+			auto en = m_enumerator;
+			std::size_t index = 0;
+
+			ForEachRemaining(en, [&](Type& object)
+			{
+				action(object, index++);
+			});
+		}
+
+		// TakeWhile Internal
+		LinqObject<Enumerator<Type, std::pair<Enum, std::size_t>>> TakeWhileInternal(std::function<bool(Type, std::size_t)> predicate) const
+		{
+			return Enumerator<Type, std::pair<Enum, std::size_t>>([=](std::pair<Enum, std::size_t>& pair) -> std::optional<Type>
+			{
+				std::optional<Type> object = CppLinq::TryNextObject(pair.first);
+
+				if (!object || !predicate(*object, pair.second++))
+				{
+					return std::nullopt;
+				}
+
+				return object;
+			}, std::make_pair(m_enumerator, std::size_t(0)));
+		}
+
+		// SkipWhile Internal
+		LinqObject<Enumerator<Type, std::pair<Enum, std::size_t>>> SkipWhileInternal(std::function<bool(Type, std::size_t)> predicate) const
+		{
+			return Enumerator<Type, std::pair<Enum, std::size_t>>([=](std::pair<Enum, std::size_t>& pair) -> std::optional<Type>
+			{
+				if (pair.second != 0)
+				{
+					return CppLinq::TryNextObject(pair.first);
+				}
+
+				for (std::optional<Type> object = CppLinq::TryNextObject(pair.first); object; object = CppLinq::TryNextObject(pair.first))
+				{
+					if (!predicate(*object, pair.second++))
+					{
+						return object;
+					}
+				}
+
+				return std::nullopt;
+			}, std::make_pair(m_enumerator, std::size_t(0)));
+		}
+
+		// Aggregate
+		template <typename Ret, typename Func>
+		Ret Aggregate(Ret start, Func accumulate) const
+		{
+			auto en = m_enumerator;
+
+			ForEachRemaining(en, [&](Type& object)
+			{
+				start = accumulate(start, object);
+			});
+
+			return start;
+		}
+
+		// Elect
+		template <typename Func>
+		Type Elect(Func accumulate) const
+		{
+			auto en = m_enumerator;
+			Type result = en.NextObject();
+
+			ForEachRemaining(en, [&](Type& object)
+			{
+				result = accumulate(result, object);
+			});
+
+			return result;
+		}
+
+		// Elect By (keeps the first object whose key is not beaten; each key is computed once)
+		template <typename Func, typename Better>
+		Type ElectBy(Func transform, Better better) const
+		{
+			auto en = m_enumerator;
+			Type result = en.NextObject();
+			std::decay_t<decltype(transform(result))> resultKey = transform(result);
+
+			ForEachRemaining(en, [&](Type& object)
+			{
+				auto key = transform(object);
+
+				if (better(key, resultKey))
+				{
+					result = object;
+					resultKey = std::move(key);
+				}
+			});
+
+			return result;
+		}
+
+		// To Sorted Vector (stable, so the first of equivalent objects stays first)
+		std::vector<Type> ToSortedVector() const
+		{
+			std::vector<Type> objects = ToVector();
+
+			if constexpr (!IsSortedEnumerator<Enum>::value)
+			{
+				std::stable_sort(objects.begin(), objects.end());
+			}
+
+			return objects;
+		}
+
+		// Last Of Sorted (the largest object of a sorted source: read directly from containers and contiguous
+		// sources, else the last one pulled)
+		Type LastOfSorted() const
+		{
+			auto en = m_enumerator;
+
+			if constexpr (IsContainerEnumerator<Enum>::value)
+			{
+				return en.Back();
+			}
+			else if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				std::size_t size = en.Size();
+				return (size == 0) ? throw EnumeratorEndException() : en.Data()[size - 1];
+			}
+			else
+			{
+				Type result = en.NextObject();
+
+				ForEachRemaining(en, [&](Type& object)
+				{
+					result = object;
+				});
+
+				return result;
+			}
+		}
+
+		// Set Operation With (a linear merge when both sources are known to be sorted, hashing otherwise)
+		template <SetOperation Operation, typename Enum2>
+		auto SetOperationWith(const Enum2& rhs) const
+		{
+			if constexpr (IsSortedEnumerator<Enum>::value && IsSortedEnumerator<Enum2>::value)
+			{
+				return LinqObject<MergeEnumerator<Enum, Enum2, Operation>>(MergeEnumerator<Enum, Enum2, Operation>(m_enumerator, rhs));
+			}
+			else
+			{
+				return LinqObject<SetOperationEnumerator<Enum, Enum2, Operation>>(SetOperationEnumerator<Enum, Enum2, Operation>(m_enumerator, rhs));
+			}
+		}
+
+		// Push Block (falls back to one Push per object for aggregators without a block loop)
+		template <typename Aggregator>
+		static void PushBlock(Aggregator& aggregator, const Type* objects, std::size_t size)
+		{
+			if constexpr (HasPushBlock<Aggregator, Type>::value)
+			{
+				aggregator.PushBlock(objects, size);
+			}
+			else
+			{
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					aggregator.Push(objects[i]);
+				}
+			}
+		}
+
+		// ParallelScan over the objects of the sequence
+		template <typename Ret, typename Func, typename Reduce, typename Combine>
+		std::vector<Ret> ParallelScanWith(Ret seed, Func accumulate, Reduce reduce, Combine combine, std::size_t threadCount) const
+		{
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				std::vector<Ret> result(m_enumerator.Size());
+				ParallelScanInternal(m_enumerator.Data(), result.data(), result.size(), seed, accumulate, reduce, combine, threadCount);
+
+				return result;
+			}
+			else
+			{
+				std::vector<Type> objects = ToVector();
+				std::vector<Ret> result(objects.size());
+				ParallelScanInternal(objects.data(), result.data(), result.size(), seed, accumulate, reduce, combine, threadCount);
+
+				return result;
+			}
+		}
+
+		// ParallelScan Internal (reduce(begin, end) totals a block, combine chains the totals)
+		template <typename Ret, typename Func, typename Reduce, typename Combine>
+		static void ParallelScanInternal(const Type* objects, Ret* result, std::size_t size, Ret seed, Func accumulate, Reduce reduce, Combine combine, std::size_t threadCount)
+		{
+			const std::size_t minBlockSize = 1 << 14;
+			std::size_t blockCount = std::max<std::size_t>(std::min(threadCount, size / minBlockSize), 1);
+			std::size_t blockSize = (size + blockCount - 1) / blockCount;
+
+			auto scanBlock = [&](std::size_t block, Ret accumulator)
+			{
+				for (std::size_t i = block * blockSize, end = std::min(size, i + blockSize); i < end; ++i)
+				{
+					accumulator = accumulate(accumulator, objects[i]);
+					result[i] = accumulator;
+				}
+			};
+
+			if (blockCount == 1)
+			{
+				scanBlock(0, seed);
+				return;
+			}
+
+			// Pass 1: total of every block but the last
+			std::vector<std::future<Ret>> totals;
+
+			for (std::size_t block = 0; block + 1 < blockCount; ++block)
+			{
+				totals.emplace_back(std::async(std::launch::async, [&, block]()
+				{
+					const Type* begin = objects + block * blockSize;
+					return reduce(begin, begin + blockSize);
+				}));
+			}
+
+			std::vector<Ret> offsets(1, seed);
+
+			for (std::future<Ret>& total : totals)
+			{
+				offsets.emplace_back(combine(offsets.back(), total.get()));
+			}
+
+			// Pass 2: scan every block from its offset
+			std::vector<std::future<void>> scans;
+
+			for (std::size_t block = 0; block < blockCount; ++block)
+			{
+				scans.emplace_back(std::async(std::launch::async, scanBlock, block, offsets[block]));
+			}
+
+			for (std::future<void>& scan : scans)
+			{
+				scan.get();
+			}
+		}
+
+	public:
+		Enum m_enumerator;
+
+		using value_type = typename Enum::value_type;
+
+		LinqObject(Enum enumerator) : m_enumerator(enumerator)
+		{
+
+		}
+
+		Type NextObject()
+		{
+			return m_enumerator.NextObject();
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			return CppLinq::TryNextObject(m_enumerator);
+		}
+
+		// Standard iteration (range-based for, <algorithm> and std::ranges)
+		// Contiguous sources are walked through plain pointers, other pipelines through a LinqIterator.
+		auto begin() const
+		{
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				return m_enumerator.Data();
+			}
+			else
+			{
+				return LinqIterator<Enum>(m_enumerator);
+			}
+		}
+
+		auto end() const
+		{
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				return m_enumerator.Data() + m_enumerator.Size();
+			}
+			else
+			{
+				return LinqSentinel();
+			}
+		}
+
+		// Select
+		template <typename Ret>
+		LinqObject<decltype(QueryRewriter<Enum>::Select(std::declval<const Enum&>(), std::declval<std::function<Ret(Type)>>()))>
+			Select(std::function<Ret(Type)> transform) const
+		{
+			return QueryRewriter<Enum>::Select(m_enumerator, transform);
+		}
+
+		template <typename Func>
+		LinqObject<decltype(QueryRewriter<Enum>::Select(std::declval<const Enum&>(), std::declval<Func>()))> Select(Func transform) const
+		{
+			return QueryRewriter<Enum>::Select(m_enumerator, transform);
+		}
+
+		// Select (member projection; over a ColumnTable only that column is read)
+		template <typename Ret, typename Class, typename = std::enable_if_t<std::is_same<Class, Type>::value>>
+		auto Select(Ret Class::* member) const
+		{
+			if constexpr (IsTableEnumerator<Enum>::value)
+			{
+				return LinqObject<decltype(m_enumerator.Project(member))>(m_enumerator.Project(member));
+			}
+			else
+			{
+				return Select([member](const Type& object) { return object.*member; });
+			}
+		}
+
+		// Where
+		template <typename Func>
+		LinqObject<decltype(QueryRewriter<Enum>::Where(std::declval<const Enum&>(), std::declval<Func>()))> Where(Func predicate) const
+		{
+			return QueryRewriter<Enum>::Where(m_enumerator, predicate);
+		}
+
+		// Where (predicate on one member; over a ColumnTable only that column is scanned)
+		template <typename Ret, typename Class, typename Func, typename = std::enable_if_t<std::is_same<Class, Type>::value>>
+		auto Where(Ret Class::* member, Func predicate) const
+		{
+			if constexpr (IsTableEnumerator<Enum>::value)
+			{
+				return LinqObject<decltype(m_enumerator.Filter(member, predicate))>(m_enumerator.Filter(member, predicate));
+			}
+			else
+			{
+				return Where([member, predicate](const Type& object) { return predicate(object.*member); });
+			}
+		}
+
+		// OrderBy
+		template <typename Ret>
+		LinqObject<OrderByEnumerator<Enum, std::function<Ret(Type)>>> OrderBy(std::function<Ret(Type)> transform) const
+		{
+			return OrderByEnumerator<Enum, std::function<Ret(Type)>>(m_enumerator, transform);
+		}
+
+		template <typename Func>
+		LinqObject<OrderByEnumerator<Enum, Func>> OrderBy(Func transform) const
+		{
+			return OrderByEnumerator<Enum, Func>(m_enumerator, transform);
+		}
+
+		// A source that is already sorted is returned as is
+		auto OrderBy() const
+		{
+			if constexpr (IsSortedEnumerator<Enum>::value)
+			{
+				return *this;
+			}
+			else
+			{
+				return OrderBy(IdentityTransform());
+			}
+		}
+
+		// AsSorted (promises that the objects are in ascending order, enabling the sorted fast paths)
+		LinqObject<SortedEnumerator<Enum>> AsSorted() const
+		{
+			return SortedEnumerator<Enum>(m_enumerator);
+		}
+
+		// LowerBound (the objects of a sorted sequence from the first one not less than value)
+		LinqObject<BoundEnumerator<Enum>> LowerBound(const Type& value) const
+		{
+			static_assert(IsSortedEnumerator<Enum>::value, "LowerBound needs a sorted sequence (see AsSorted)");
+			return BoundEnumerator<Enum>(m_enumerator, value, false);
+		}
+
+		// EqualRange (the objects of a sorted sequence that are equivalent to value)
+		LinqObject<BoundEnumerator<Enum>> EqualRange(const Type& value) const
+		{
+			static_assert(IsSortedEnumerator<Enum>::value, "EqualRange needs a sorted sequence (see AsSorted)");
+			return BoundEnumerator<Enum>(m_enumerator, value, true);
+		}
+
+		// Foreach
+		void Foreach(std::function<void(Type)> action) const
+		{
+			ForeachInternal([=](Type a, std::size_t) { return action(a); });
+		}
+
+		// ForeachBatch (action receives Span<const Type> blocks of up to size objects, each valid during its call)
+		template <typename Func>
+		void ForeachBatch(std::size_t size, Func action) const
+		{
+			ChunkEnumerator<Enum> en(m_enumerator, size);
+
+			en.ForEachRemaining([&](Span<const Type>& batch)
+			{
+				action(batch);
+			});
+		}
+
+		// Take
+		LinqObject<TakeEnumerator<Enum>> Take(std::size_t count) const
+		{
+			return TakeEnumerator<Enum>(m_enumerator, count);
+		}
+
+		// TakeWhile
+		LinqObject<Enumerator<Type, std::pair<Enum, std::size_t>>> TakeWhile(std::function<bool(Type)> predicate) const
+		{
+			return TakeWhileInternal([=](Type t, std::size_t) { return predicate(t); });
+		}
+
+		// Skip
+		LinqObject<SkipEnumerator<Enum>> Skip(std::size_t count) const
+		{
+			return SkipEnumerator<Enum>(m_enumerator, count);
+		}
+
+		// SkipWhile
+		LinqObject<Enumerator<Type, std::pair<Enum, std::size_t>>> SkipWhile(std::function<bool(Type)> predicate) const
+		{
+			return SkipWhileInternal([=](Type t, std::size_t) { return predicate(t); });
+		}
+
+		// Cast
+		template <typename Ret>
+		LinqObject<decltype(QueryRewriter<Enum>::Select(std::declval<const Enum&>(), std::declval<std::function<Ret(Type)>>()))> Cast() const
+		{
+			return Select<Ret>([](Type a) { return static_cast<Ret>(a); });
+		}
+
+		// Distinct
+		template <typename Ret>
+		LinqObject<Enumerator<Type, std::pair<Enum, std::set<Ret>>>> Distinct(std::function<Ret(Type)> transform) const
+		{
+			using DataType = std::pair<Enum, std::set<Ret>>;
+
+			return Enumerator<Type, DataType>([=](DataType& pair) -> std::optional<Type>
+			{
+				for (std::optional<Type> object = CppLinq::TryNextObject(pair.first); object; object = CppLinq::TryNextObject(pair.first))
+				{
+					if (pair.second.insert(transform(*object)).second)
+					{
+						return object;
+					}
+				}
+
+				return std::nullopt;
+			}, std::make_pair(m_enumerator, std::set<Ret>()));
+		}
+
+		template <typename Func>
+		LinqObject<Enumerator<Type, std::pair<Enum, std::set<decltype(GetReturnType<Func, Type>())>>>> Distinct(Func transform) const
+		{
+			return Distinct<decltype(GetReturnType<Func, Type>())>(transform);
+		}
+
+		// A sorted source only needs to compare neighbours
+		auto Distinct() const
+		{
+			if constexpr (IsSortedEnumerator<Enum>::value)
+			{
+				return LinqObject<AdjacentDistinctEnumerator<Enum>>(AdjacentDistinctEnumerator<Enum>(m_enumerator));
+			}
+			else
+			{
+				return Distinct<Type>([](Type a) { return a; });
+			}
+		}
+		
+		// Reverse
+		LinqObject<ReverseEnumerator<Enum>> Reverse() const
+		{
+			return ReverseEnumerator<Enum>(m_enumerator);
+		}
+
+		// Explain (operator tree with cardinalities, buffering and the fast paths that apply)
+		QueryPlan Explain() const
+		{
+			return ExplainQuery(m_enumerator);
+		}
+
+		// With Profiling (stages added from here on record their statistics into profile)
+		// A no-op unless CPP_LINQ_PROFILING is defined, so profiled queries cost nothing by default.
+		// Profiled stages are wrapped one by one, so the rewrites that fuse adjacent stages do not apply.
+#if defined(CPP_LINQ_PROFILING)
+		ProfiledLinqObject<Enum> WithProfiling(QueryProfile& profile) const
+		{
+			return ProfileEnumerator<Enum>(m_enumerator, profile, "Source");
+		}
+#else
+		LinqObject WithProfiling(QueryProfile&) const
+		{
+			return *this;
+		}
+#endif
+
+		// Partition (splits an unordered container source into count disjoint bucket ranges)
+		// Each part is an independent query, so the parts can be enumerated on different threads.
+		auto Partition(std::size_t count) const
+		{
+			static_assert(IsContainerEnumerator<Enum>::value, "Partition needs an unordered container source");
+
+			using Container = typename std::decay<decltype(m_enumerator.Source())>::type;
+			static_assert(!IsOrderedContainer<Container>::value, "Partition needs an unordered container source");
+
+			const Container& container = m_enumerator.Source();
+			std::size_t bucketCount = container.bucket_count();
+			count = std::max<std::size_t>(1, std::min(count, bucketCount));
+
+			std::vector<LinqObject<BucketEnumerator<Type, Container>>> parts;
+			parts.reserve(count);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				parts.emplace_back(BucketEnumerator<Type, Container>(container, bucketCount * i / count, bucketCount * (i + 1) / count));
+			}
+
+			return parts;
+		}
+
+		// Memoize (the pipeline runs once; later enumerations replay its objects)
+		LinqObject<MemoizeEnumerator<Enum>> Memoize() const
+		{
+			return MemoizeEnumerator<Enum>(m_enumerator);
+		}
+
+		// Sum
+		template <typename Ret>
+		Ret Sum(std::function<Ret(Type)> transform) const
+		{
+			return Aggregate<Ret>(Ret(), [=](Ret accumulator, Type object)
+			{
+				return accumulator + transform(object);
+			});
+		}
+
+		template <typename Func>
+		decltype(GetReturnType<Func, Type>()) Sum(Func transform) const
+		{
+			using Ret = decltype(GetReturnType<Func, Type>());
+
+			return Aggregate<Ret>(Ret(), [&](Ret accumulator, const Type& object)
+			{
+				return accumulator + transform(object);
+			});
+		}
+
+		template <typename Ret>
+		Ret Sum() const
+		{
+			return Aggregate<Ret>(Ret(), [](Ret accumulator, const Type& object)
+			{
+				return accumulator + object;
+			});
+		}
+
+		Type Sum() const
+		{
+			return Sum<Type>();
+		}
+
+		// Average
+		template <typename Ret>
+		Ret Average(std::function<Ret(Type)> transform) const
+		{
+			using Sum = typename WideType<Ret>::type;
+
+			std::size_t count = 0;
+
+			Sum sum = Aggregate<Sum>(Sum(), [&](Sum accumulator, Type object) -> Sum
+			{
+				count++;
+				return accumulator + static_cast<Sum>(transform(object));
+			});
+
+			return (count == 0) ? Ret() : static_cast<Ret>(sum / static_cast<Sum>(count));
+		}
+
+		template <typename Func>
+		decltype(GetReturnType<Func, Type>()) Average(Func transform) const
+		{
+			return Average<decltype(GetReturnType<Func, Type>())>(transform);
+		}
+
+		template <typename Ret>
+		Ret Average() const
+		{
+			return Average<Ret>([](Type a) { return a; });
+		}
+
+		Type Average() const
+		{
+			return Average<Type>();
+		}
+
+		// Count
+		std::size_t Count(std::function<bool(Type)> predicate) const
+		{
+			return Aggregate<std::size_t>(0, [=](std::size_t count, Type a)
+			{
+				return count + (predicate(a) ? 1 : 0);
+			});
+		}
+
+		std::size_t Count(const Type& value) const
+		{
+			if constexpr (IsContainerEnumerator<Enum>::value)
+			{
+				return m_enumerator.Count(value);
+			}
+			else
+			{
+				return Count([=](Type a) { return a == value; });
+			}
+		}
+
+		std::size_t Count() const
+		{
+			return QueryRewriter<Enum>::Count(m_enumerator);
+		}
+
+		// LongCount (signed 64-bit count)
+		std::int64_t LongCount(std::function<bool(Type)> predicate) const
+		{
+			return static_cast<std::int64_t>(Count(predicate));
+		}
+
+		std::int64_t LongCount() const
+		{
+			return static_cast<std::int64_t>(Count());
+		}
+
+		// AggregateMany (several aggregates of the sequence in a single pass)
+		// Contiguous sources are fed block by block so each aggregator runs its own tight loop over
+		// data that is still in cache.
+		template <template <typename> class... Aggregators>
+		std::tuple<decltype(std::declval<const Aggregators<Type>&>().Result())...> AggregateMany() const
+		{
+			const std::size_t blockSize = 1024;
+
+			std::tuple<Aggregators<Type>...> aggregators;
+			auto en = m_enumerator;
+
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				const Type* objects = en.Data();
+				std::size_t size = en.Size();
+
+				for (std::size_t offset = 0; offset < size; offset += blockSize)
+				{
+					std::size_t count = std::min(blockSize, size - offset);
+
+					std::apply([&](auto&... aggregator)
+					{
+						(PushBlock(aggregator, objects + offset, count), ...);
+					}, aggregators);
+				}
+			}
+			else
+			{
+				ForEachRemaining(en, [&](Type& object)
+				{
+					std::apply([&](auto&... aggregator)
+					{
+						(aggregator.Push(object), ...);
+					}, aggregators);
+				});
+			}
+
+			return std::apply([](const auto&... aggregator)
+			{
+				return std::make_tuple(aggregator.Result()...);
+			}, aggregators);
+		}
+
+		// Any
+		bool Any(std::function<bool(Type)> predicate) const
+		{
+			try
+			{
+				auto en = m_enumerator;
+
+				while (true)
+				{
+					if (predicate(en.NextObject()))
+					{
+						return true;
+					}
+				}
+			}
+			catch (EnumeratorEndException&)
+			{
+				
+			}
+
+			return false;
+		}
+
+		bool Any() const
+		{
+			return Any([](Type a) { return static_cast<bool>(a); });
+		}
+
+		// All
+		bool All(std::function<bool(Type)> predicate) const
+		{
+			return !Any([=](Type a) { return !predicate(a); });
+		}
+
+		bool All() const
+		{
+			return All([](Type a) { return static_cast<bool>(a); });
+		}
+
+		// Contains (container lookup for associative sources, binary search over sorted contiguous
+		// sources; other sorted sources stop past value)
+		bool Contains(const Type& value) const
+		{
+			if constexpr (IsContainerEnumerator<Enum>::value)
+			{
+				return m_enumerator.Contains(value);
+			}
+			else if constexpr (IsSortedEnumerator<Enum>::value)
+			{
+				BoundEnumerator<Enum> en(m_enumerator, value, true);
+				return CppLinq::TryNextObject(en).has_value();
+			}
+			else
+			{
+				return Any([&](Type a) { return value == a; });
+			}
+		}
+
+		// Max
+		template <typename Ret>
+		Type Max(std::function<Ret(Type)> transform) const
+		{
+			return MaxBy(transform);
+		}
+
+		template <typename Func>
+		Type Max(Func transform) const
+		{
+			return MaxBy(transform);
+		}
+
+		Type Max() const
+		{
+			if constexpr (IsSortedEnumerator<Enum>::value)
+			{
+				return LastOfSorted();
+			}
+			else if constexpr (IsContiguousEnumerator<Enum>::value && std::is_arithmetic<Type>::value)
+			{
+				return std::get<0>(AggregateMany<AggregateMax>());
+			}
+			else
+			{
+				return MaxBy([](const Type& a) -> const Type& { return a; });
+			}
+		}
+
+		// Min
+		template <typename Ret>
+		Type Min(std::function<Ret(Type)> transform) const
+		{
+			return MinBy(transform);
+		}
+
+		template <typename Func>
+		Type Min(Func transform) const
+		{
+			return MinBy(transform);
+		}
+
+		Type Min() const
+		{
+			if constexpr (IsSortedEnumerator<Enum>::value)
+			{
+				auto en = m_enumerator;
+				return en.NextObject();
+			}
+			else if constexpr (IsContiguousEnumerator<Enum>::value && std::is_arithmetic<Type>::value)
+			{
+				return std::get<0>(AggregateMany<AggregateMin>());
+			}
+			else
+			{
+				return MinBy([](const Type& a) -> const Type& { return a; });
+			}
+		}
+
+		// MaxBy (the first object with the largest key)
+		template <typename Func>
+		Type MaxBy(Func transform) const
+		{
+			return ElectBy(transform, [](const auto& key, const auto& best) { return best < key; });
+		}
+
+		// MinBy (the first object with the smallest key)
+		template <typename Func>
+		Type MinBy(Func transform) const
+		{
+			return ElectBy(transform, [](const auto& key, const auto& best) { return key < best; });
+		}
+
+		// MinMax (the first smallest and the last largest object, as std::minmax_element)
+		// Objects are taken in pairs: the pair is ordered with one comparison and then only its smaller
+		// object is compared with the minimum and its larger one with the maximum, about 3n/2 comparisons.
+		template <typename Func>
+		std::pair<Type, Type> MinMax(Func transform) const
+		{
+			using Key = std::decay_t<decltype(transform(std::declval<Type&>()))>;
+
+			auto en = m_enumerator;
+			Type first = en.NextObject();
+			Key firstKey = transform(first);
+
+			std::pair<Type, Type> result(first, first);
+			Key minKey = firstKey;
+			Key maxKey = firstKey;
+			std::optional<std::pair<Type, Key>> pending;
+
+			auto update = [&](Type& small, Key& smallKey, Type& large, Key& largeKey)
+			{
+				if (smallKey < minKey)
+				{
+					result.first = small;
+					minKey = std::move(smallKey);
+				}
+
+				if (!(largeKey < maxKey))
+				{
+					result.second = large;
+					maxKey = std::move(largeKey);
+				}
+			};
+
+			ForEachRemaining(en, [&](Type& object)
+			{
+				if (!pending)
+				{
+					pending.emplace(object, transform(object));
+					return;
+				}
+
+				Key key = transform(object);
+
+				if (key < pending->second)
+				{
+					update(object, key, pending->first, pending->second);
+				}
+				else
+				{
+					update(pending->first, pending->second, object, key);
+				}
+
+				pending.reset();
+			});
+
+			if (pending)
+			{
+				Key key = pending->second;
+				update(pending->first, pending->second, pending->first, key);
+			}
+
+			return result;
+		}
+
+		std::pair<Type, Type> MinMax() const
+		{
+			if constexpr (IsSortedEnumerator<Enum>::value)
+			{
+				return std::make_pair(Min(), Max());
+			}
+			else if constexpr (IsContiguousEnumerator<Enum>::value && std::is_arithmetic<Type>::value)
+			{
+				auto extrema = AggregateMany<AggregateMin, AggregateMax>();
+				return std::make_pair(std::get<0>(extrema), std::get<1>(extrema));
+			}
+			else
+			{
+				return MinMax([](const Type& a) -> const Type& { return a; });
+			}
+		}
+
+		// ElementAt
+		Type ElementAt(size_t index) const
+		{
+			auto en = m_enumerator;
+
+			for (size_t i = 0; i < index; ++i)
+			{
+				en.NextObject();
+			}
+
+			return en.NextObject();
+		}
+
+		// First
+		Type First(std::function<bool(Type)> predicate) const
+		{
+			return Where(predicate).First();
+		}
+
+		Type First() const
+		{
+			return QueryRewriter<Enum>::First(m_enumerator);
+		}
+
+		Type FirstOrDefault(std::function<bool(Type)> predicate) const
+		{
+			try
+			{
+				return First(predicate);
+			}
+			catch (EnumeratorEndException&)
+			{
+				return Type();
+			}
+		}
+
+		Type FirstOrDefault() const
+		{
+			try
+			{
+				return First();
+			}
+			catch(EnumeratorEndException&)
+			{
+				return Type();
+			}
+		}
+
+		// Last
+		Type Last(std::function<bool(Type)> predicate) const
+		{
+			auto clause = Where(predicate);
+			Type object = clause.m_enumerator.NextObject();
+
+			try
+			{
+				while (true)
+				{
+					object = clause.m_enumerator.NextObject();
+				}
+			}
+			catch (EnumeratorEndException&)
+			{
+				return object;
+			}
+		}
+
+		Type Last() const
+		{
+			if constexpr (IsContainerEnumerator<Enum>::value && IsOrderedContainer<typename std::decay<decltype(m_enumerator.Source())>::type>::value)
+			{
+				return m_enumerator.Back();
+			}
+			else
+			{
+				return Last([](Type) { return true; });
+			}
+		}
+
+		Type LastOrDefault(std::function<bool(Type)> predicate) const
+		{
+			try
+			{
+				return Last(predicate);
+			}
+			catch (EnumeratorEndException&)
+			{
+				return Type();
+			}
+		}
+
+		Type LastOrDefault() const
+		{
+			return LastOrDefault([](Type) { return true; });
+		}
+
+		// Concat
+		template <typename Enum2>
+		LinqObject<decltype(QueryRewriter<Enum>::Concat(std::declval<const Enum&>(), std::declval<const Enum2&>()))> Concat(LinqObject<Enum2> rhs) const
+		{
+			return QueryRewriter<Enum>::Concat(m_enumerator, rhs.m_enumerator);
+		}
+
+		// Union (distinct objects of both sequences)
+		template <typename Enum2>
+		auto Union(LinqObject<Enum2> rhs) const
+		{
+			return SetOperationWith<SetOperation::Union>(rhs.m_enumerator);
+		}
+
+		// Intersect (distinct objects of this sequence that are also in rhs)
+		template <typename Enum2>
+		auto Intersect(LinqObject<Enum2> rhs) const
+		{
+			return SetOperationWith<SetOperation::Intersect>(rhs.m_enumerator);
+		}
+
+		// Except (distinct objects of this sequence that are not in rhs)
+		template <typename Enum2>
+		auto Except(LinqObject<Enum2> rhs) const
+		{
+			return SetOperationWith<SetOperation::Except>(rhs.m_enumerator);
+		}
+
+		// Chunk (Span<const Type> blocks; a block may be invalidated once the next one is pulled)
+		LinqObject<ChunkEnumerator<Enum>> Chunk(std::size_t size) const
+		{
+			return ChunkEnumerator<Enum>(m_enumerator, size);
+		}
+
+		// Scan
+		template <typename Ret, typename Func>
+		LinqObject<ScanEnumerator<Enum, Ret, Func>> Scan(Ret seed, Func accumulate) const
+		{
+			return ScanEnumerator<Enum, Ret, Func>(m_enumerator, seed, accumulate);
+		}
+
+		// ParallelScan (returns the same objects as Scan)
+		// Blocks are reduced in parallel, their offsets chained in order, then each block is
+		// scanned in parallel from its offset. Non-contiguous sources are materialized first.
+		// Without combine, accumulate must be associative over Type and totals blocks by itself.
+		template <typename Ret, typename Func>
+		std::vector<Ret> ParallelScan(Ret seed, Func accumulate, std::size_t threadCount = std::thread::hardware_concurrency()) const
+		{
+			static_assert(std::is_same<Ret, Type>::value, "ParallelScan: pass combine and identity when the seed is not of the object type");
+
+			auto reduce = [accumulate](const Type* begin, const Type* end)
+			{
+				Ret total = *begin;
+
+				for (const Type* object = begin + 1; object != end; ++object)
+				{
+					total = accumulate(total, *object);
+				}
+
+				return total;
+			};
+
+			return ParallelScanWith(seed, accumulate, reduce, accumulate, threadCount);
+		}
+
+		// With combine, blocks are totaled by accumulate from identity and chained by combine, so
+		// combine(a, total of a block) must equal accumulating that block from a (e.g. a count
+		// accumulated as long long over int objects combines with +, identity 0).
+		template <typename Ret, typename Func, typename Combine>
+		std::vector<Ret> ParallelScan(Ret seed, Func accumulate, Combine combine, Ret identity, std::size_t threadCount = std::thread::hardware_concurrency()) const
+		{
+			auto reduce = [accumulate, identity](const Type* begin, const Type* end)
+			{
+				Ret total = identity;
+
+				for (const Type* object = begin; object != end; ++object)
+				{
+					total = accumulate(total, *object);
+				}
+
+				return total;
+			};
+
+			return ParallelScanWith(seed, accumulate, reduce, combine, threadCount);
+		}
+
+		// Window (aggregator provides Push, Pop and Result, e.g. WindowSum, WindowAverage, WindowMin, WindowMax)
+		template <typename Aggregator>
+		LinqObject<WindowEnumerator<Enum, Aggregator>> Window(std::size_t size, Aggregator aggregator) const
+		{
+			return WindowEnumerator<Enum, Aggregator>(m_enumerator, size, aggregator);
+		}
+
+		template <template <typename> class Aggregator>
+		LinqObject<WindowEnumerator<Enum, Aggregator<Type>>> Window(std::size_t size) const
+		{
+			return Window(size, Aggregator<Type>());
+		}
+
+		// Zip
+		template <typename Enum2, typename Func>
+		LinqObject<ZipEnumerator<Func, Enum, Enum2>> Zip(LinqObject<Enum2> rhs, Func transform) const
+		{
+			return ZipEnumerator<Func, Enum, Enum2>(transform, m_enumerator, rhs.m_enumerator);
+		}
+
+		// SelectMany (transform returns a LinqObject for each object)
+		template <typename Func>
+		LinqObject<SelectManyEnumerator<Enum, Func>> SelectMany(Func transform) const
+		{
+			return SelectManyEnumerator<Enum, Func>(m_enumerator, transform);
+		}
+
+		// AsAnyEnumerable
+		LinqObject<AnyEnumerable<Type>> AsAnyEnumerable() const
+		{
+			return AnyEnumerable<Type>(m_enumerator);
+		}
+
+		// Export to container
+		template <typename Container, typename Func>
+		Container ToContainer(Func func) const
+		{
+			Container container;
+			auto en = m_enumerator;
+
+			Reserve(container, SizeOf(en));
+
+			ForEachRemaining(en, [&](Type& object)
+			{
+				func(container, object);
+			});
+
+			return container;
+		}
+
+		// Export methods
+		std::vector<Type> ToVector() const
+		{
+			if constexpr (IsContiguousEnumerator<Enum>::value)
+			{
+				const Type* objects = m_enumerator.Data();
+				return std::vector<Type>(objects, objects + m_enumerator.Size());
+			}
+			else
+			{
+				return ToContainer<std::vector<Type>>([](std::vector<Type>& container, const Type& value)
+				{
+					container.emplace_back(value);
+				});
+			}
+		}
+
+		std::list<Type> ToList() const
+		{
+			return ToContainer<std::list<Type>>([](std::list<Type>& container, const Type& value)
+			{
+				container.emplace_back(value);
+			});
+		}
+
+		std::deque<Type> ToDeque() const
+		{
+			return ToContainer<std::deque<Type>>([](std::deque<Type>& container, const Type& value)
+			{
+				container.emplace_back(value);
+			});
+		}
+
+		// Built from sorted objects, so every insertion lands at the end of the tree
+		std::set<Type> ToSet() const
+		{
+			std::vector<Type> objects = ToSortedVector();
+			return std::set<Type>(objects.begin(), objects.end());
+		}
+
+		std::unordered_set<Type> ToUnorderedSet() const
+		{
+			return ToContainer<std::unordered_set<Type>>([](std::unordered_set<Type>& container, const Type& value)
+			{
+				container.insert(value);
+			});
+		}
+
+		// ToFlatSet (sorted std::vector without duplicates)
+		std::vector<Type> ToFlatSet() const
+		{
+			std::vector<Type> objects = ToSortedVector();
+			objects.erase(std::unique(objects.begin(), objects.end(), [](const Type& a, const Type& b) { return !(a < b); }), objects.end());
+
+			return objects;
+		}
+
+		// ToDictionary (one value per key; throws std::invalid_argument for a duplicate key)
+		template <typename KeyFunc, typename ValueFunc>
+		auto ToDictionary(KeyFunc key, ValueFunc value) const
+		{
+			using Key = typename std::decay<decltype(key(std::declval<Type&>()))>::type;
+			using Value = typename std::decay<decltype(value(std::declval<Type&>()))>::type;
+
+			LookupMap<Key, Value> dictionary;
+			auto en = m_enumerator;
+
+			Reserve(dictionary, SizeOf(en));
+
+			ForEachRemaining(en, [&](Type& object)
+			{
+				if (!dictionary.emplace(key(object), value(object)).second)
+				{
+					throw std::invalid_argument("ToDictionary: duplicate key");
+				}
+			});
+
+			return dictionary;
+		}
+
+		template <typename KeyFunc>
+		auto ToDictionary(KeyFunc key) const
+		{
+			return ToDictionary(key, IdentityTransform());
+		}
+
+		// ToLookup (every object grouped by key)
+		template <typename KeyFunc>
+		Lookup<typename std::decay<decltype(std::declval<KeyFunc&>()(std::declval<Type&>()))>::type, Type> ToLookup(KeyFunc key) const
+		{
+			return Lookup<typename std::decay<decltype(std::declval<KeyFunc&>()(std::declval<Type&>()))>::type, Type>(ToVector(), key);
+		}
+
+		// Export to std::array (throws std::length_error unless there are exactly N objects)
+		template <std::size_t N>
+		std::array<Type, N> ToArray() const
+		{
+			std::array<Type, N> result{};
+			auto en = m_enumerator;
+
+			for (std::size_t i = 0; i < N; ++i)
+			{
+				std::optional<Type> object = CppLinq::TryNextObject(en);
+
+				if (!object)
+				{
+					throw std::length_error("ToArray: fewer objects than the array size");
+				}
+
+				result[i] = std::move(*object);
+			}
+
+			if (CppLinq::TryNextObject(en))
+			{
+				throw std::length_error("ToArray: more objects than the array size");
+			}
+
+			return result;
+		}
+	};
+
+	// Iterator Enumerator (source over an iterator range)
+	template <typename Type, typename Iter>
+	class IteratorEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		IteratorEnumerator(Iter begin, Iter end) :
+			m_current(begin), m_end(end)
+		{
+
+		}
+
+		Type NextObject()
+		{
+			return (m_current == m_end) ? throw EnumeratorEndException() : *(m_current++);
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			return (m_current == m_end) ? std::nullopt : std::optional<Type>(*(m_current++));
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			for (; m_current != m_end; ++m_current)
+			{
+				Type object = *m_current;
+				action(object);
+			}
+		}
+
+		// Objects left to enumerate (contiguous iterators only)
+		const Type* Data() const
+		{
+			return (m_current == m_end) ? nullptr : std::addressof(*m_current);
+		}
+
+		void Advance(std::size_t count)
+		{
+			std::advance(m_current, count);
+		}
+
+		std::size_t Size() const
+		{
+			if constexpr (std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>::value)
+			{
+				return static_cast<std::size_t>(m_end - m_current);
+			}
+			else
+			{
+				return UnknownSize;
+			}
+		}
+
+	private:
+		Iter m_current;
+		Iter m_end;
+	};
+
+	template <typename Type, typename Iter>
+	struct IsContiguousEnumerator<IteratorEnumerator<Type, Iter>> : IsContiguousIterator<Type, Iter> { };
+
+	// Container Enumerator (source over an associative container)
+	// Keeps a reference to the container, so Contains, Count, Min, Max and Last applied directly to the
+	// source use its own lookups instead of a scan. Once objects have been pulled, Contains and Count
+	// scan the objects that are left instead.
+	template <typename Type, typename Container>
+	class ContainerEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		ContainerEnumerator(const Container& container) :
+			m_container(&container), m_current(container.begin()), m_size(container.size())
+		{
+
+		}
+
+		Type NextObject()
+		{
+			return (m_current == m_container->end()) ? throw EnumeratorEndException() : (--m_size, *(m_current++));
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			return (m_current == m_container->end()) ? std::nullopt : (--m_size, std::optional<Type>(*(m_current++)));
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			for (; m_current != m_container->end(); ++m_current)
+			{
+				Type object = *m_current;
+				action(object);
+			}
+
+			m_size = 0;
+		}
+
+		std::size_t Size() const
+		{
+			return m_size;
+		}
+
+		const Container& Source() const
+		{
+			return *m_container;
+		}
+
+		// Lookups over the objects left (maps find the key, then compare the mapped value)
+		bool Contains(const Type& value) const
+		{
+			if (m_current != m_container->begin())
+			{
+				return std::any_of(m_current, m_container->end(), [&](const typename Container::value_type& object) { return Type(object) == value; });
+			}
+
+			if constexpr (IsMapContainer<Container>::value)
+			{
+				auto range = m_container->equal_range(value.first);
+				return std::any_of(range.first, range.second, [&](const typename Container::value_type& object) { return object.second == value.second; });
+			}
+			else
+			{
+				return m_container->find(value) != m_container->end();
+			}
+		}
+
+		std::size_t Count(const Type& value) const
+		{
+			if (m_current != m_container->begin())
+			{
+				return static_cast<std::size_t>(std::count_if(m_current, m_container->end(), [&](const typename Container::value_type& object) { return Type(object) == value; }));
+			}
+
+			if constexpr (IsMapContainer<Container>::value)
+			{
+				auto range = m_container->equal_range(value.first);
+				return static_cast<std::size_t>(std::count_if(range.first, range.second, [&](const typename Container::value_type& object) { return object.second == value.second; }));
+			}
+			else
+			{
+				return m_container->count(value);
+			}
+		}
+
+		// Last object of an ordered container (still ahead of the cursor unless every object was pulled)
+		Type Back() const
+		{
+			return (m_current == m_container->end()) ? throw EnumeratorEndException() : Type(*m_container->rbegin());
+		}
+
+	private:
+		const Container* m_container;
+		typename Container::const_iterator m_current;
+		std::size_t m_size;
+	};
+
+	template <typename Type, typename Container>
+	struct IsContainerEnumerator<ContainerEnumerator<Type, Container>> : std::true_type { };
+
+	// Bucket Enumerator (objects of the buckets [firstBucket, lastBucket) of an unordered container)
+	// Disjoint bucket ranges cover the container exactly once, so they can be enumerated in parallel.
+	template <typename Type, typename Container>
+	class BucketEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		BucketEnumerator(const Container& container, std::size_t firstBucket, std::size_t lastBucket) :
+			m_container(&container), m_firstBucket(firstBucket), m_bucket(firstBucket), m_lastBucket(lastBucket),
+			m_current(container.cend(0)), m_end(m_current)
+		{
+
+		}
+
+		Type NextObject()
+		{
+			std::optional<Type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			while (m_current == m_end)
+			{
+				if (m_bucket == m_lastBucket)
+				{
+					return std::nullopt;
+				}
+
+				m_current = m_container->cbegin(m_bucket);
+				m_end = m_container->cend(m_bucket);
+				++m_bucket;
+			}
+
+			return Type(*(m_current++));
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			while (true)
+			{
+				for (; m_current != m_end; ++m_current)
+				{
+					Type object = *m_current;
+					action(object);
+				}
+
+				if (m_bucket == m_lastBucket)
+				{
+					break;
+				}
+
+				m_current = m_container->cbegin(m_bucket);
+				m_end = m_container->cend(m_bucket);
+				++m_bucket;
+			}
+		}
+
+		const Container& Source() const
+		{
+			return *m_container;
+		}
+
+		std::size_t FirstBucket() const
+		{
+			return m_firstBucket;
+		}
+
+		std::size_t LastBucket() const
+		{
+			return m_lastBucket;
+		}
+
+	private:
+		const Container* m_container;
+		std::size_t m_firstBucket;
+		std::size_t m_bucket;
+		std::size_t m_lastBucket;
+		typename Container::const_local_iterator m_current;
+		typename Container::const_local_iterator m_end;
+	};
+
+	template <typename Type, typename Container>
+	struct IsSortedEnumerator<ContainerEnumerator<Type, Container>> : IsAscendingContainer<Container> { };
+
+	// Column Table (Row objects stored as struct-of-arrays, one std::vector per listed member)
+	// Queries over the table scan only the columns they name, and rows are rebuilt from the columns
+	// only for the rows that pass every filter. Every member of Row must therefore be listed; for an
+	// aggregate Row a missing member does not compile.
+	template <typename Row, auto... Members>
+	class ColumnTable
+	{
+		template <typename Type>
+		struct MemberType;
+
+		template <typename Type, typename Class>
+		struct MemberType<Type Class::*>
+		{
+			using type = Type;
+		};
+
+		// Converts to any member type, so brace-initializing Row with it counts the members of Row
+		struct AnyMember
+		{
+			template <typename Type>
+			operator Type() const;
+		};
+
+		template <typename Indices, typename = void>
+		struct IsInitializableFrom : std::false_type { };
+
+		template <std::size_t... Is>
+		struct IsInitializableFrom<std::index_sequence<Is...>, decltype(void(Row{ (void(Is), AnyMember())... }))> : std::true_type { };
+
+		static_assert(sizeof...(Members) > 0, "ColumnTable: list the members of Row");
+		static_assert(std::is_default_constructible<Row>::value, "ColumnTable: rows are rebuilt from a default-constructed Row");
+		static_assert(!std::is_aggregate<Row>::value || !IsInitializableFrom<std::make_index_sequence<sizeof...(Members) + 1>>::value,
+			"ColumnTable: every member of Row must be listed, since rows are rebuilt from the columns");
+
+	public:
+		using value_type = Row;
+
+		// Whether some listed member is of type Type
+		template <typename Type>
+		static constexpr bool HasColumnOf()
+		{
+			return (std::is_same<decltype(Members), Type Row::*>::value || ...);
+		}
+
+		void Add(const Row& row)
+		{
+			AddInternal(row, std::index_sequence_for<decltype(Members)...>());
+		}
+
+		void Reserve(std::size_t size)
+		{
+			std::apply([&](auto&... columns)
+			{
+				(columns.reserve(size), ...);
+			}, m_columns);
+		}
+
+		std::size_t Size() const
+		{
+			return std::get<0>(m_columns).size();
+		}
+
+		// Row at index, rebuilt from the columns
+		Row RowAt(std::size_t index) const
+		{
+			return RowAtInternal(index, std::index_sequence_for<decltype(Members)...>());
+		}
+
+		// Column of member (members of a type no column has do not compile; an unlisted member of a
+		// listed type throws std::invalid_argument)
+		template <typename Type>
+		const std::vector<Type>& Column(Type Row::* member) const
+		{
+			static_assert(HasColumnOf<Type>(), "ColumnTable: no column has the type of this member");
+
+			const std::vector<Type>* result = nullptr;
+			FindColumn(member, result, std::index_sequence_for<decltype(Members)...>());
+
+			return result ? *result : throw std::invalid_argument("ColumnTable: the member is not a column");
+		}
+
+	private:
+		template <std::size_t... Is>
+		void AddInternal(const Row& row, std::index_sequence<Is...>)
+		{
+			(std::get<Is>(m_columns).push_back(row.*Members), ...);
+		}
+
+		template <std::size_t... Is>
+		Row RowAtInternal(std::size_t index, std::index_sequence<Is...>) const
+		{
+			Row row{};
+			((row.*Members = std::get<Is>(m_columns)[index]), ...);
+
+			return row;
+		}
+
+		template <typename Type, std::size_t... Is>
+		void FindColumn(Type Row::* member, const std::vector<Type>*& result, std::index_sequence<Is...>) const
+		{
+			(MatchColumn<Members>(member, std::get<Is>(m_columns), result), ...);
+		}
+
+		template <auto Member, typename Type, typename Column>
+		static void MatchColumn(Type Row::* member, const Column& column, const std::vector<Type>*& result)
+		{
+			if constexpr (std::is_same<decltype(Member), Type Row::*>::value)
+			{
+				if (Member == member)
+				{
+					result = &column;
+				}
+			}
+		}
+
+		std::tuple<std::vector<typename MemberType<decltype(Members)>::type>...> m_columns;
+	};
+
+	// Table Filter (appends to result the rows, among rows or all rows when rows is null, that pass the filter)
+	template <typename Table>
+	using TableFilter = std::function<void(const Table&, const std::vector<std::size_t>*, std::vector<std::size_t>&)>;
+
+	// Table Filters (a filter and the filters added before it; never changed once built, so queries share them)
+	// Rows are selected anew by every enumeration, which sees rows added and predicate state changed since.
+	template <typename Table>
+	class TableFilters
+	{
+	public:
+		TableFilters(TableFilter<Table> filter, std::shared_ptr<const TableFilters> parent) :
+			m_filter(std::move(filter)), m_parent(std::move(parent))
+		{
+
+		}
+
+		std::vector<std::size_t> SelectRows(const Table& table) const
+		{
+			std::vector<std::size_t> rows;
+
+			if (m_parent)
+			{
+				std::vector<std::size_t> parentRows = m_parent->SelectRows(table);
+				m_filter(table, &parentRows, rows);
+			}
+			else
+			{
+				m_filter(table, nullptr, rows);
+			}
+
+			return rows;
+		}
+
+		std::size_t Count() const
+		{
+			return m_parent ? m_parent->Count() + 1 : 1;
+		}
+
+	private:
+		TableFilter<Table> m_filter;
+		std::shared_ptr<const TableFilters> m_parent;
+	};
+
+	// Table Column Enumerator (one column of a filtered table, gathered at the selected rows)
+	// The rows are selected on the first pull and kept by this enumerator only.
+	template <typename Table, typename Type>
+	class TableColumnEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		TableColumnEnumerator(const Table& table, const std::vector<Type>& column, std::shared_ptr<const TableFilters<Table>> filters,
+			std::optional<std::vector<std::size_t>> rows = std::nullopt, std::size_t position = 0) :
+			m_table(&table), m_column(&column), m_filters(std::move(filters)), m_rows(std::move(rows)), m_position(position)
+		{
+
+		}
+
+		Type NextObject()
+		{
+			std::optional<Type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			const std::vector<std::size_t>& rows = Rows();
+			return (m_position == rows.size()) ? std::nullopt : std::optional<Type>((*m_column)[rows[m_position++]]);
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			const std::vector<std::size_t>& rows = Rows();
+
+			for (; m_position < rows.size(); ++m_position)
+			{
+				Type object = (*m_column)[rows[m_position]];
+				action(object);
+			}
+		}
+
+		// Known once the rows have been selected
+		std::size_t Size() const
+		{
+			return m_rows ? m_rows->size() - m_position : UnknownSize;
+		}
+
+		std::size_t FilterCount() const
+		{
+			return m_filters->Count();
+		}
+
+	private:
+		const std::vector<std::size_t>& Rows()
+		{
+			if (!m_rows)
+			{
+				m_rows = m_filters->SelectRows(*m_table);
+			}
+
+			return *m_rows;
+		}
+
+		const Table* m_table;
+		const std::vector<Type>* m_column;
+		std::shared_ptr<const TableFilters<Table>> m_filters;
+		std::optional<std::vector<std::size_t>> m_rows;
+		std::size_t m_position;
+	};
+
+	// Table Enumerator (rows of a ColumnTable, rebuilt one at a time; IsFiltered when Where added
+	// column filters). Select(&Row::member) over it reads a single column: contiguously when nothing is
+	// filtered, otherwise gathered at the selected rows. Where(&Row::member, predicate) adds a filter
+	// that scans only that column, and only at the rows the earlier filters selected. The rows are
+	// selected on the first pull of each enumeration, so every terminal runs the filters once.
+	template <typename Table, bool IsFiltered>
+	class TableEnumerator
+	{
+	public:
+		using value_type = typename Table::value_type;
+
+		TableEnumerator(const Table& table, std::shared_ptr<const TableFilters<Table>> filters = nullptr) :
+			m_table(&table), m_filters(std::move(filters)), m_position(0)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			if constexpr (IsFiltered)
+			{
+				const std::vector<std::size_t>& rows = Rows();
+				return (m_position == rows.size()) ? std::nullopt : std::optional<value_type>(m_table->RowAt(rows[m_position++]));
+			}
+			else
+			{
+				return (m_position == m_table->Size()) ? std::nullopt : std::optional<value_type>(m_table->RowAt(m_position++));
+			}
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			if constexpr (IsFiltered)
+			{
+				const std::vector<std::size_t>& rows = Rows();
+
+				for (; m_position < rows.size(); ++m_position)
+				{
+					value_type object = m_table->RowAt(rows[m_position]);
+					action(object);
+				}
+			}
+			else
+			{
+				for (; m_position < m_table->Size(); ++m_position)
+				{
+					value_type object = m_table->RowAt(m_position);
+					action(object);
+				}
+			}
+		}
+
+		// Known for a filtered table once the rows have been selected
+		std::size_t Size() const
+		{
+			if constexpr (IsFiltered)
+			{
+				return m_rows ? m_rows->size() - m_position : UnknownSize;
+			}
+			else
+			{
+				return m_table->Size() - m_position;
+			}
+		}
+
+		// Number of rows left, selecting them without rebuilding any
+		std::size_t CountRows()
+		{
+			if constexpr (IsFiltered)
+			{
+				return Rows().size() - m_position;
+			}
+			else
+			{
+				return m_table->Size() - m_position;
+			}
+		}
+
+		// Adds a filter on one column
+		template <typename Type, typename Pred>
+		TableEnumerator<Table, true> Filter(Type value_type::* member, Pred predicate) const
+		{
+			const std::vector<Type>& column = m_table->Column(member);
+
+			TableFilter<Table> filter = [&column, predicate](const Table&, const std::vector<std::size_t>* rows, std::vector<std::size_t>& result)
+			{
+				if (rows == nullptr)
+				{
+					for (std::size_t i = 0; i < column.size(); ++i)
+					{
+						if (predicate(column[i]))
+						{
+							result.push_back(i);
+						}
+					}
+				}
+				else
+				{
+					for (std::size_t i : *rows)
+					{
+						if (predicate(column[i]))
+						{
+							result.push_back(i);
+						}
+					}
+				}
+			};
+
+			return TableEnumerator<Table, true>(*m_table, std::make_shared<const TableFilters<Table>>(std::move(filter), m_filters));
+		}
+
+		// One column of the rows left to enumerate
+		template <typename Type>
+		auto Project(Type value_type::* member) const
+		{
+			const std::vector<Type>& column = m_table->Column(member);
+
+			if constexpr (IsFiltered)
+			{
+				return TableColumnEnumerator<Table, Type>(*m_table, column, m_filters, m_rows, m_position);
+			}
+			else
+			{
+				return IteratorEnumerator<Type, const Type*>(column.data() + m_position, column.data() + column.size());
+			}
+		}
+
+		const Table& Source() const
+		{
+			return *m_table;
+		}
+
+		std::size_t FilterCount() const
+		{
+			return m_filters ? m_filters->Count() : 0;
+		}
+
+	private:
+		const std::vector<std::size_t>& Rows()
+		{
+			if (!m_rows)
+			{
+				m_rows = m_filters->SelectRows(*m_table);
+			}
+
+			return *m_rows;
+		}
+
+		const Table* m_table;
+		std::shared_ptr<const TableFilters<Table>> m_filters;
+		std::optional<std::vector<std::size_t>> m_rows;
+		std::size_t m_position;
+	};
+
+	// From(table).Where(&T::field, pred).Count() => selected rows counted without rebuilding them
+	template <typename Table>
+	class QueryRewriter<TableEnumerator<Table, true>> : public QueryRewriterBase<TableEnumerator<Table, true>>
+	{
+	public:
+		static std::size_t Count(const TableEnumerator<Table, true>& source)
+		{
+			auto en = source;
+			return en.CountRows();
+		}
+	};
+
+	template <typename Table, bool IsFiltered>
+	struct IsTableEnumerator<TableEnumerator<Table, IsFiltered>> : std::true_type { };
+
+	// Repeat Enumerator (one value, count times; the count may exceed 2^32)
+	template <typename Type>
+	class RepeatEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		RepeatEnumerator(Type value, std::size_t count) :
+			m_value(value), m_count(count), m_index(0)
+		{
+
+		}
+
+		Type NextObject()
+		{
+			return (m_index == m_count) ? throw EnumeratorEndException() : (m_index++, m_value);
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			return (m_index == m_count) ? std::nullopt : (m_index++, std::optional<Type>(m_value));
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			for (; m_index != m_count; ++m_index)
+			{
+				Type object = m_value;
+				action(object);
+			}
+		}
+
+		const Type& Value() const
+		{
+			return m_value;
+		}
+
+		std::size_t Size() const
+		{
+			return m_count - m_index;
+		}
+
+	private:
+		Type m_value;
+		std::size_t m_count;
+		std::size_t m_index;
+	};
+
+	template <typename Type>
+	struct IsSortedEnumerator<RepeatEnumerator<Type>> : std::true_type { };
+
+#if defined(__cpp_lib_ranges)
+	// View Enumerator (source over a std::ranges view)
+	// Iterators belong to the view they came from, so the view is kept on the heap and shared by
+	// copies: a copied cursor keeps its iterator without walking the view again.
+	template <typename View>
+	class ViewEnumerator
+	{
+	public:
+		using value_type = std::ranges::range_value_t<View>;
+
+		ViewEnumerator(View view) :
+			m_view(std::make_shared<View>(std::move(view))), m_current(std::ranges::begin(*m_view)), m_index(0)
+		{
+
+		}
+
+		value_type NextObject()
+		{
+			std::optional<value_type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<value_type> TryNextObject()
+		{
+			if (m_current == std::ranges::end(*m_view))
+			{
+				return std::nullopt;
+			}
+
+			value_type object = *m_current;
+			++m_current;
+			++m_index;
+
+			return object;
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			for (auto end = std::ranges::end(*m_view); m_current != end; ++m_current, ++m_index)
+			{
+				value_type object = *m_current;
+				action(object);
+			}
+		}
+
+		std::size_t Size() const
+		{
+			if constexpr (std::ranges::sized_range<const View>)
+			{
+				return static_cast<std::size_t>(std::ranges::size(*m_view)) - m_index;
+			}
+			else
+			{
+				return UnknownSize;
+			}
+		}
+
+	private:
+		std::shared_ptr<View> m_view;
+		std::ranges::iterator_t<View> m_current;
+		std::size_t m_index;
+	};
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	// Coroutine Frame Allocator
+	// Released frames are kept in a small per-thread cache and handed out again to frames of the
+	// same size, so a generator started once per query or per element does not hit the heap.
+	class CoroutineFrameAllocator
+	{
+		static constexpr std::size_t CacheSize = 16;
+
+		struct Cache
+		{
+			~Cache()
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					::operator delete(frames[i]);
+				}
+			}
+
+			void* frames[CacheSize];
+			std::size_t sizes[CacheSize];
+			std::size_t count = 0;
+		};
+
+		static Cache& GetCache()
+		{
+			thread_local Cache cache;
+			return cache;
+		}
+
+	public:
+		static void* Allocate(std::size_t size)
+		{
+			Cache& cache = GetCache();
+
+			for (std::size_t i = 0; i < cache.count; ++i)
+			{
+				if (cache.sizes[i] == size)
+				{
+					void* frame = cache.frames[i];
+
+					--cache.count;
+					cache.frames[i] = cache.frames[cache.count];
+					cache.sizes[i] = cache.sizes[cache.count];
+
+					return frame;
+				}
+			}
+
+			return ::operator new(size);
+		}
+
+		static void Deallocate(void* frame, std::size_t size)
+		{
+			Cache& cache = GetCache();
+
+			if (cache.count == CacheSize)
+			{
+				::operator delete(frame);
+				return;
+			}
+
+			cache.frames[cache.count] = frame;
+			cache.sizes[cache.count] = size;
+			++cache.count;
+		}
+	};
+
+	// Generator (coroutine producing objects with co_yield)
+	template <typename Type>
+	class Generator
+	{
+	public:
+		class promise_type
+		{
+		public:
+			Generator get_return_object()
+			{
+				return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+
+			std::suspend_always initial_suspend() noexcept
+			{
+				return {};
+			}
+
+			std::suspend_always final_suspend() noexcept
+			{
+				return {};
+			}
+
+			// The yielded object lives in the coroutine until it is resumed, so only its address is kept
+			std::suspend_always yield_value(const Type& object) noexcept
+			{
+				m_current = std::addressof(object);
+				return {};
+			}
+
+			std::suspend_always yield_value(Type&& object) noexcept
+			{
+				m_current = std::addressof(object);
+				return {};
+			}
+
+			void return_void()
+			{
+
+			}
+
+			void unhandled_exception()
+			{
+				m_exception = std::current_exception();
+			}
+
+			static void* operator new(std::size_t size)
+			{
+				return CoroutineFrameAllocator::Allocate(size);
+			}
+
+			static void operator delete(void* frame, std::size_t size)
+			{
+				CoroutineFrameAllocator::Deallocate(frame, size);
+			}
+
+			const Type* m_current = nullptr;
+			std::exception_ptr m_exception;
+		};
+
+		Generator(Generator&& other) noexcept :
+			m_handle(std::exchange(other.m_handle, nullptr))
+		{
+
+		}
+
+		Generator& operator=(Generator other) noexcept
+		{
+			std::swap(m_handle, other.m_handle);
+			return *this;
+		}
+
+		~Generator()
+		{
+			if (m_handle)
+			{
+				m_handle.destroy();
+			}
+		}
+
+		// Runs the coroutine up to its next co_yield; false once it has returned or was moved from
+		bool Next()
+		{
+			if (!m_handle || m_handle.done())
+			{
+				return false;
+			}
+
+			m_handle.resume();
+
+			if (m_handle.promise().m_exception)
+			{
+				std::rethrow_exception(std::exchange(m_handle.promise().m_exception, nullptr));
+			}
+
+			return !m_handle.done();
+		}
+
+		const Type& Current() const
+		{
+			return *m_handle.promise().m_current;
+		}
+
+	private:
+		explicit Generator(std::coroutine_handle<promise_type> handle) :
+			m_handle(handle)
+		{
+
+		}
+
+		std::coroutine_handle<promise_type> m_handle;
+	};
+
+	// Generator Enumerator (source over a coroutine)
+	// A coroutine cannot be copied: a copy taken before the first pull starts its own coroutine from
+	// the factory, while copies of a running enumerator share its coroutine like input iterators do.
+	// The factory is shared too, so enumerators over a lambda stay copy-assignable.
+	template <typename Type, typename Factory = std::function<Generator<Type>()>>
+	class GeneratorEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		GeneratorEnumerator(Factory factory) :
+			m_factory(std::make_shared<Factory>(std::move(factory)))
+		{
+
+		}
+
+		GeneratorEnumerator(Generator<Type> generator) :
+			m_generator(std::make_shared<Generator<Type>>(std::move(generator)))
+		{
+
+		}
+
+		Type NextObject()
+		{
+			std::optional<Type> object = TryNextObject();
+			return object ? *object : throw EnumeratorEndException();
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			Generator<Type>& generator = Start();
+			return generator.Next() ? std::optional<Type>(generator.Current()) : std::nullopt;
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			for (Generator<Type>& generator = Start(); generator.Next();)
+			{
+				Type object = generator.Current();
+				action(object);
+			}
+		}
+
+	private:
+		Generator<Type>& Start()
+		{
+			if (!m_generator)
+			{
+				m_generator = std::make_shared<Generator<Type>>((*m_factory)());
+			}
+
+			return *m_generator;
+		}
+
+		std::shared_ptr<Factory> m_factory;
+		std::shared_ptr<Generator<Type>> m_generator;
+	};
+#endif
+
+	// Arithmetic Enumerator (closed-form source behind Range)
+	template <typename Type>
+	class ArithmeticEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		ArithmeticEnumerator(Type first, Type step, std::size_t count) :
+			m_first(first), m_step(step), m_count(count), m_index(0)
+		{
+
+		}
+
+		Type NextObject()
+		{
+			return (m_index == m_count) ? throw EnumeratorEndException() : At(m_index++);
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			return (m_index == m_count) ? std::nullopt : std::optional<Type>(At(m_index++));
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			for (; m_index < m_count; ++m_index)
+			{
+				Type object = At(m_index);
+				action(object);
+			}
+		}
+
+		// Number of objects left to enumerate
+		std::size_t Size() const
+		{
+			return m_count - m_index;
+		}
+
+		// Object at the given position relative to the current one
+		Type ElementAt(std::size_t index) const
+		{
+			return At(m_index + index);
+		}
+
+		Type Step() const
+		{
+			return m_step;
+		}
+
+		ArithmeticEnumerator Slice(std::size_t skip, std::size_t take) const
+		{
+			skip = std::min(skip, Size());
+			return ArithmeticEnumerator(At(m_index + skip), m_step, std::min(take, Size() - skip));
+		}
+
+	private:
+		Type At(std::size_t index) const
+		{
+			using Offset = typename OffsetType<Type>::type;
+			return static_cast<Type>(static_cast<Offset>(m_first) + static_cast<Offset>(index) * static_cast<Offset>(m_step));
+		}
+
+		Type m_first;
+		Type m_step;
+		std::size_t m_count;
+		std::size_t m_index;
+	};
+
+	// Range objects ascend (the step is positive or the range is empty)
+	template <typename Type>
+	struct IsSortedEnumerator<ArithmeticEnumerator<Type>> : std::true_type { };
+
+	// Profiled Linq Object (query whose stages are each wrapped in a ProfileEnumerator)
+	// Stage operators forward to LinqObject and profile the stage they add; terminals are inherited.
+	template <typename Enum>
+	class ProfiledLinqObject : public LinqObject<ProfileEnumerator<Enum>>
+	{
+		using Base = LinqObject<ProfileEnumerator<Enum>>;
+
+		template <typename Enum2>
+		ProfiledLinqObject<Enum2> Stage(const LinqObject<Enum2>& stage, const char* name) const
+		{
+			return ProfileEnumerator<Enum2>(stage.m_enumerator, this->m_enumerator.Profile(), name);
+		}
+
+	public:
+		using Base::Base;
+
+		template <typename... Args>
+		auto Select(Args&&... args) const
+		{
+			return Stage(Base::Select(std::forward<Args>(args)...), "Select");
+		}
+
+		template <typename... Args>
+		auto Where(Args&&... args) const
+		{
+			return Stage(Base::Where(std::forward<Args>(args)...), "Where");
+		}
+
+		template <typename... Args>
+		auto OrderBy(Args&&... args) const
+		{
+			return Stage(Base::OrderBy(std::forward<Args>(args)...), "OrderBy");
+		}
+
+		auto Take(std::size_t count) const
+		{
+			return Stage(Base::Take(count), "Take");
+		}
+
+		template <typename... Args>
+		auto TakeWhile(Args&&... args) const
+		{
+			return Stage(Base::TakeWhile(std::forward<Args>(args)...), "TakeWhile");
+		}
+
+		auto Skip(std::size_t count) const
+		{
+			return Stage(Base::Skip(count), "Skip");
+		}
+
+		template <typename... Args>
+		auto SkipWhile(Args&&... args) const
+		{
+			return Stage(Base::SkipWhile(std::forward<Args>(args)...), "SkipWhile");
+		}
+
+		template <typename Ret>
+		auto Cast() const
+		{
+			return Stage(Base::template Cast<Ret>(), "Cast");
+		}
+
+		auto Distinct() const
+		{
+			return Stage(Base::Distinct(), "Distinct");
+		}
+
+		auto Reverse() const
+		{
+			return Stage(Base::Reverse(), "Reverse");
+		}
+
+		auto Memoize() const
+		{
+			return Stage(Base::Memoize(), "Memoize");
+		}
+
+		template <typename... Args>
+		auto Concat(Args&&... args) const
+		{
+			return Stage(Base::Concat(std::forward<Args>(args)...), "Concat");
+		}
+
+		template <typename... Args>
+		auto Union(Args&&... args) const
+		{
+			return Stage(Base::Union(std::forward<Args>(args)...), "Union");
+		}
+
+		template <typename... Args>
+		auto Intersect(Args&&... args) const
+		{
+			return Stage(Base::Intersect(std::forward<Args>(args)...), "Intersect");
+		}
+
+		template <typename... Args>
+		auto Except(Args&&... args) const
+		{
+			return Stage(Base::Except(std::forward<Args>(args)...), "Except");
+		}
+
+		template <typename... Args>
+		auto SelectMany(Args&&... args) const
+		{
+			return Stage(Base::SelectMany(std::forward<Args>(args)...), "SelectMany");
+		}
+
+		template <typename... Args>
+		auto Zip(Args&&... args) const
+		{
+			return Stage(Base::Zip(std::forward<Args>(args)...), "Zip");
+		}
+
+		auto Chunk(std::size_t size) const
+		{
+			return Stage(Base::Chunk(size), "Chunk");
+		}
+
+		template <typename... Args>
+		auto Scan(Args&&... args) const
+		{
+			return Stage(Base::Scan(std::forward<Args>(args)...), "Scan");
+		}
+
+		template <typename Aggregator>
+		auto Window(std::size_t size, Aggregator aggregator) const
+		{
+			return Stage(Base::Window(size, aggregator), "Window");
+		}
+
+		template <template <typename> class Aggregator>
+		auto Window(std::size_t size) const
+		{
+			return Stage(Base::template Window<Aggregator>(size), "Window");
+		}
+	};
+
+	// Arithmetic Linq Object
+	// Range result that answers size-, position- and value-based queries in constant time.
+	template <typename Type>
+	class ArithmeticLinqObject : public LinqObject<ArithmeticEnumerator<Type>>
+	{
+		using Base = LinqObject<ArithmeticEnumerator<Type>>;
+
+	public:
+		using Base::Base;
+		using Base::Count;
+		using Base::Sum;
+		using Base::Average;
+		using Base::Max;
+		using Base::Min;
+		using Base::Contains;
+
+		// Take
+		ArithmeticLinqObject Take(std::size_t count) const
+		{
+			return this->m_enumerator.Slice(0, count);
+		}
+
+		// Skip
+		ArithmeticLinqObject Skip(std::size_t count) const
+		{
+			return this->m_enumerator.Slice(count, this->m_enumerator.Size());
+		}
+
+		// Sum
+		Type Sum() const
+		{
+			std::size_t count = this->m_enumerator.Size();
+
+			if (count == 0)
+			{
+				return Type();
+			}
+
+			using Offset = typename OffsetType<Type>::type;
+
+			// count * (count - 1) / 2 without overflowing the intermediate product
+			std::size_t triangle = (count % 2 == 0) ? (count / 2) * (count - 1) : count * ((count - 1) / 2);
+
+			return static_cast<Type>(static_cast<Offset>(count) * static_cast<Offset>(this->m_enumerator.ElementAt(0)) +
+				static_cast<Offset>(triangle) * static_cast<Offset>(this->m_enumerator.Step()));
+		}
+
+		// Average
+		Type Average() const
+		{
+			using Offset = typename OffsetType<Type>::type;
+
+			std::size_t count = this->m_enumerator.Size();
+
+			if (count == 0)
+			{
+				return Type();
+			}
+
+			// Halfway from the first object to the last one (last - first is exact in Offset for integers)
+			Offset first = static_cast<Offset>(this->m_enumerator.ElementAt(0));
+			Offset last = static_cast<Offset>(this->m_enumerator.ElementAt(count - 1));
+
+			return static_cast<Type>(first + (last - first) / 2);
+		}
+
+		// Count
+		std::size_t Count() const
+		{
+			return this->m_enumerator.Size();
+		}
+
+		// Contains
+		bool Contains(const Type& value) const
+		{
+			std::size_t count = this->m_enumerator.Size();
+
+			if (count == 0 || value < Min() || Max() < value)
+			{
+				return false;
+			}
+
+			using Offset = typename OffsetType<Type>::type;
+
+			Offset offset = (static_cast<Offset>(value) - static_cast<Offset>(this->m_enumerator.ElementAt(0))) / static_cast<Offset>(this->m_enumerator.Step());
+			std::size_t index = 0;
+
+			if constexpr (std::is_integral<Type>::value)
+			{
+				index = static_cast<std::size_t>(offset);
+			}
+			else
+			{
+				index = static_cast<std::size_t>(std::round(offset));
+			}
+
+			return index < count && this->m_enumerator.ElementAt(index) == value;
+		}
+
+		// Max
+		Type Max() const
+		{
+			return ElementAt(this->m_enumerator.Size() - 1);
+		}
+
+		// Min
+		Type Min() const
+		{
+			return ElementAt(0);
+		}
+
+		// MinMax
+		std::pair<Type, Type> MinMax() const
+		{
+			return std::make_pair(Min(), Max());
+		}
+
+		// ElementAt
+		Type ElementAt(size_t index) const
+		{
+			return (index < this->m_enumerator.Size()) ?
+				this->m_enumerator.ElementAt(index) : throw EnumeratorEndException();
+		}
+
+		// Export methods (the indexed fill loop has no loop-carried dependency, so it vectorizes)
+		std::vector<Type> ToVector() const
+		{
+			using Offset = typename OffsetType<Type>::type;
+
+			std::vector<Type> result(this->m_enumerator.Size());
+			Type* data = result.data();
+			Offset first = static_cast<Offset>(this->m_enumerator.ElementAt(0));
+			Offset step = static_cast<Offset>(this->m_enumerator.Step());
+
+			for (std::size_t i = 0; i < result.size(); ++i)
+			{
+				data[i] = static_cast<Type>(first + static_cast<Offset>(i) * step);
+			}
+
+			return result;
+		}
+	};
+
+	// Channel (bounded lock-free queue from producer threads to one consumer thread)
+	// Producers claim slots with a compare-and-swap on the tail and publish them through a per-slot
+	// sequence number; the consumer takes published slots in batches into a private buffer.
+	template <typename Type>
+	class Channel
+	{
+		static constexpr std::size_t BatchSize = 64;
+
+		struct Slot
+		{
+			std::atomic<std::size_t> sequence;
+			Type object;
+		};
+
+		bool TryPush(Type& object)
+		{
+			std::size_t position = m_tail.load(std::memory_order_relaxed);
+
+			while (true)
+			{
+				Slot& slot = m_slots[position & m_mask];
+				std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+				if (sequence == position)
+				{
+					if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						slot.object = std::move(object);
+						slot.sequence.store(position + 1, std::memory_order_release);
+
+						return true;
+					}
+				}
+				else if (sequence < position)
+				{
+					return false;
+				}
+				else
+				{
+					position = m_tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+	public:
+		// The capacity is rounded up to a power of two
+		explicit Channel(std::size_t capacity) :
+			m_slots(nullptr), m_mask(0), m_tail(0), m_isClosed(false), m_head(0), m_position(0), m_count(0)
+		{
+			std::size_t size = 1;
+
+			while (size < capacity)
+			{
+				size <<= 1;
+			}
+
+			m_slots.reset(new Slot[size]);
+			m_mask = size - 1;
+
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				m_slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		Channel(const Channel&) = delete;
+		Channel& operator=(const Channel&) = delete;
+
+		// Queues object unless the channel is full or closed
+		bool TrySend(Type object)
+		{
+			return !IsClosed() && TryPush(object);
+		}
+
+		// Queues object, waiting while the channel is full; false once it is closed
+		bool Send(Type object)
+		{
+			while (!IsClosed())
+			{
+				if (TryPush(object))
+				{
+					return true;
+				}
+
+				std::this_thread::yield();
+			}
+
+			return false;
+		}
+
+		// Ends the sequence after the objects already sent (call it once every producer is done)
+		void Close()
+		{
+			m_isClosed.store(true, std::memory_order_release);
+		}
+
+		bool IsClosed() const
+		{
+			return m_isClosed.load(std::memory_order_acquire);
+		}
+
+		std::size_t Capacity() const
+		{
+			return m_mask + 1;
+		}
+
+		// Moves up to batch.Size() published objects into batch without waiting (consumer thread only)
+		std::size_t TryReceiveBatch(Span<Type> batch)
+		{
+			std::size_t count = 0;
+
+			for (; count < batch.Size() && m_position < m_count; ++count)
+			{
+				batch[count] = std::move(m_buffer[m_position++]);
+			}
+
+			for (; count < batch.Size(); ++count)
+			{
+				Slot& slot = m_slots[m_head & m_mask];
+
+				if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+				{
+					break;
+				}
+
+				batch[count] = std::move(slot.object);
+				slot.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+				++m_head;
+			}
+
+			return count;
+		}
+
+		// Waits for at least one object; 0 once the channel is closed and drained (consumer thread only)
+		std::size_t ReceiveBatch(Span<Type> batch)
+		{
+			while (true)
+			{
+				bool isClosed = IsClosed();
+				std::size_t count = TryReceiveBatch(batch);
+
+				if (count != 0 || isClosed || batch.Size() == 0)
+				{
+					return count;
+				}
+
+				std::this_thread::yield();
+			}
+		}
+
+		// Waits for the next object; nothing once the channel is closed and drained (consumer thread only)
+		std::optional<Type> Receive()
+		{
+			if (m_position == m_count)
+			{
+				m_buffer.resize(BatchSize);
+				m_count = ReceiveBatch(Span<Type>(m_buffer.data(), m_buffer.size()));
+				m_position = 0;
+
+				if (m_count == 0)
+				{
+					return std::nullopt;
+				}
+			}
+
+			return std::move(m_buffer[m_position++]);
+		}
+
+	private:
+		std::unique_ptr<Slot[]> m_slots;
+		std::size_t m_mask;
+
+		alignas(64) std::atomic<std::size_t> m_tail;
+		std::atomic<bool> m_isClosed;
+
+		alignas(64) std::size_t m_head;
+		std::vector<Type> m_buffer;
+		std::size_t m_position;
+		std::size_t m_count;
+	};
+
+	// Channel Enumerator (consumer side of a Channel; copies share the channel)
+	template <typename Type>
+	class ChannelEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		ChannelEnumerator(Channel<Type>& channel) :
+			m_channel(&channel)
+		{
+
+		}
+
+		Type NextObject()
+		{
+			std::optional<Type> object = TryNextObject();
+			return object ? std::move(*object) : throw EnumeratorEndException();
+		}
+
+		std::optional<Type> TryNextObject()
+		{
+			return m_channel->Receive();
+		}
+
+		template <typename Action>
+		void ForEachRemaining(Action&& action)
+		{
+			std::vector<Type> batch(64);
+
+			for (std::size_t count; (count = m_channel->ReceiveBatch(Span<Type>(batch.data(), batch.size()))) != 0;)
+			{
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					action(batch[i]);
+				}
+			}
+		}
+
+	private:
+		Channel<Type>* m_channel;
+	};
+
+	// Query Explainer specialisations (one per kind of stage)
+	template <typename Enum, typename = void>
+	struct IsEnumerator : std::false_type { };
+
+	template <typename Enum>
+	struct IsEnumerator<Enum, decltype(void(std::declval<Enum&>().NextObject()))> : std::true_type { };
+
+	template <typename Func>
+	struct IsAndPredicate : std::false_type { };
+
+	template <typename First, typename Second>
+	struct IsAndPredicate<AndPredicate<First, Second>> : std::true_type { };
+
+	template <typename Func>
+	struct IsComposedTransform : std::false_type { };
+
+	template <typename First, typename Second>
+	struct IsComposedTransform<ComposedTransform<First, Second>> : std::true_type { };
+
+	// Take, Skip, TakeWhile, SkipWhile, indexed Select/Where and From(iter, length)
+	template <typename Ret, typename Enum>
+	class QueryExplainer<Enumerator<Ret, std::pair<Enum, std::size_t>>>
+	{
+	public:
+		static QueryPlan Explain(const Enumerator<Ret, std::pair<Enum, std::size_t>>& enumerator)
+		{
+			QueryPlan plan;
+
+			if constexpr (IsEnumerator<Enum>::value)
+			{
+				plan.name = "Indexed stage (Take, Skip, TakeWhile, SkipWhile or indexed Select/Where)";
+				plan.notes.push_back("calls a std::function for every object");
+				plan.inputs.push_back(ExplainQuery(enumerator.Data().first));
+			}
+			else
+			{
+				plan.name = "Source: iterator and length";
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Ret, typename Enum, typename Type>
+	class QueryExplainer<Enumerator<Ret, std::pair<Enum, std::set<Type>>>>
+	{
+	public:
+		static QueryPlan Explain(const Enumerator<Ret, std::pair<Enum, std::set<Type>>>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Distinct", enumerator, enumerator.Data().first);
+
+			plan.cardinality = plan.inputs.front().cardinality;
+			plan.isUpperBound = (plan.cardinality != UnknownSize);
+			plan.memory = BufferSize(plan.cardinality, sizeof(Type) + 4 * sizeof(void*));
+			plan.notes.push_back("keeps every distinct object in a std::set (upper-bound memory estimate)");
+
+			return plan;
+		}
+	};
+
+	template <typename Type>
+	class QueryExplainer<RepeatEnumerator<Type>>
+	{
+	public:
+		static QueryPlan Explain(const RepeatEnumerator<Type>& enumerator)
+		{
+			QueryPlan plan;
+			plan.name = "Source: Repeat";
+			plan.cardinality = enumerator.Size();
+
+			return plan;
+		}
+	};
+
+	template <typename Type, typename Iter>
+	class QueryExplainer<IteratorEnumerator<Type, Iter>>
+	{
+	public:
+		static QueryPlan Explain(const IteratorEnumerator<Type, Iter>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = IsContiguousEnumerator<IteratorEnumerator<Type, Iter>>::value ? "Source: contiguous range" : "Source: iterator range";
+			plan.cardinality = SizeOf(enumerator);
+
+			if (IsContiguousEnumerator<IteratorEnumerator<Type, Iter>>::value)
+			{
+				plan.notes.push_back("pointer begin/end, zero-copy Chunk, indexed Zip and blocked AggregateMany");
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Type>
+	class QueryExplainer<ArithmeticEnumerator<Type>>
+	{
+	public:
+		static QueryPlan Explain(const ArithmeticEnumerator<Type>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "Source: Range";
+			plan.cardinality = enumerator.Size();
+			plan.notes.push_back("closed form: Count, Sum, Average, Min, Max, Contains, ElementAt, Take and Skip in O(1)");
+
+			return plan;
+		}
+	};
+
+	template <typename Type>
+	class QueryExplainer<AnyEnumerable<Type>>
+	{
+	public:
+		static QueryPlan Explain(const AnyEnumerable<Type>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "AnyEnumerable";
+			plan.cardinality = enumerator.Size();
+			plan.notes.push_back("type-erased pipeline, pulled only as far as the consumer asks");
+
+			return plan;
+		}
+	};
+
+	template <typename Type>
+	class QueryExplainer<ChannelEnumerator<Type>>
+	{
+	public:
+		static QueryPlan Explain(const ChannelEnumerator<Type>&)
+		{
+			QueryPlan plan;
+
+			plan.name = "Source: Channel";
+			plan.notes.push_back("waits for producers; ends when the channel is closed");
+
+			return plan;
+		}
+	};
+
+#if defined(__cpp_lib_ranges)
+	template <typename View>
+	class QueryExplainer<ViewEnumerator<View>>
+	{
+	public:
+		static QueryPlan Explain(const ViewEnumerator<View>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "Source: std::ranges view";
+			plan.cardinality = enumerator.Size();
+
+			return plan;
+		}
+	};
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	template <typename Type, typename Factory>
+	class QueryExplainer<GeneratorEnumerator<Type, Factory>>
+	{
+	public:
+		static QueryPlan Explain(const GeneratorEnumerator<Type, Factory>&)
+		{
+			QueryPlan plan;
+			plan.name = "Source: coroutine generator";
+
+			return plan;
+		}
+	};
+#endif
+
+	template <typename Enum, typename Func>
+	class QueryExplainer<WhereEnumerator<Enum, Func>>
+	{
+	public:
+		static QueryPlan Explain(const WhereEnumerator<Enum, Func>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Where", enumerator, enumerator.Source());
+
+			plan.cardinality = plan.inputs.front().cardinality;
+			plan.isUpperBound = (plan.cardinality != UnknownSize);
+
+			if (IsAndPredicate<Func>::value)
+			{
+				plan.notes.push_back("adjacent Where clauses fused into one predicate");
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Enum, typename Func>
+	class QueryExplainer<SelectEnumerator<Enum, Func>>
+	{
+	public:
+		static QueryPlan Explain(const SelectEnumerator<Enum, Func>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Select", enumerator, enumerator.Source());
+
+			if (IsComposedTransform<Func>::value)
+			{
+				plan.notes.push_back("adjacent Select clauses fused into one transform");
+			}
+
+			plan.notes.push_back("Count() skips the transform");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum, typename Func>
+	class QueryExplainer<OrderByEnumerator<Enum, Func>>
+	{
+	public:
+		static QueryPlan Explain(const OrderByEnumerator<Enum, Func>& enumerator)
+		{
+			using Pair = std::pair<typename OrderByEnumerator<Enum, Func>::key_type, typename Enum::value_type>;
+
+			QueryPlan plan = ExplainStage("OrderBy", enumerator, enumerator.Source());
+
+			plan.isPipelineBreaker = true;
+			plan.memory = BufferSize(plan.cardinality, sizeof(Pair));
+			plan.notes.push_back("stable sort of (key, object) pairs on the first pull");
+			plan.notes.push_back("First() runs as a single-pass minimum; a following Where runs before the sort");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<ReverseEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const ReverseEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Reverse", enumerator, enumerator.Source());
+
+			plan.isPipelineBreaker = true;
+			plan.memory = BufferSize(plan.cardinality, sizeof(typename Enum::value_type));
+			plan.notes.push_back("a following Where runs before the buffer is filled");
+
+			return plan;
+		}
+	};
+
+	template <typename... Enums>
+	class QueryExplainer<ConcatEnumerator<Enums...>>
+	{
+	public:
+		static QueryPlan Explain(const ConcatEnumerator<Enums...>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "Concat";
+			plan.cardinality = SizeOf(enumerator);
+
+			std::apply([&](const auto&... parts)
+			{
+				(plan.inputs.push_back(ExplainQuery(parts)), ...);
+			}, enumerator.Parts());
+
+			if (sizeof...(Enums) > 2)
+			{
+				plan.notes.push_back("Concat chain flattened into one cursor over " + std::to_string(sizeof...(Enums)) + " parts");
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<ConcatRangeEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const ConcatRangeEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "ConcatAll";
+			plan.cardinality = SizeOf(enumerator);
+
+			for (const Enum& source : enumerator.Sources())
+			{
+				plan.inputs.push_back(ExplainQuery(source));
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Enum, typename Func>
+	class QueryExplainer<SelectManyEnumerator<Enum, Func>>
+	{
+	public:
+		static QueryPlan Explain(const SelectManyEnumerator<Enum, Func>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("SelectMany", enumerator, enumerator.Source());
+
+			plan.cardinality = UnknownSize;
+			plan.isUpperBound = false;
+
+			return plan;
+		}
+	};
+
+	template <typename Func, typename... Enums>
+	class QueryExplainer<ZipEnumerator<Func, Enums...>>
+	{
+	public:
+		static QueryPlan Explain(const ZipEnumerator<Func, Enums...>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "Zip";
+			plan.cardinality = SizeOf(enumerator);
+
+			std::apply([&](const auto&... sources)
+			{
+				(plan.inputs.push_back(ExplainQuery(sources)), ...);
+			}, enumerator.Sources());
+
+			if (std::conjunction<IsContiguousEnumerator<Enums>...>::value)
+			{
+				plan.notes.push_back("indexed loop over contiguous sources");
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<ChunkEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const ChunkEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Chunk", enumerator, enumerator.Source());
+
+			if (IsContiguousEnumerator<Enum>::value)
+			{
+				plan.notes.push_back("blocks view the source directly");
+			}
+			else
+			{
+				plan.memory = enumerator.ChunkSize() * sizeof(typename Enum::value_type);
+				plan.notes.push_back("blocks view one reused buffer, valid until the next block is pulled");
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Enum, typename Ret, typename Func>
+	class QueryExplainer<ScanEnumerator<Enum, Ret, Func>>
+	{
+	public:
+		static QueryPlan Explain(const ScanEnumerator<Enum, Ret, Func>& enumerator)
+		{
+			return ExplainStage("Scan", enumerator, enumerator.Source());
+		}
+	};
+
+	template <typename Enum, typename Aggregator>
+	class QueryExplainer<WindowEnumerator<Enum, Aggregator>>
+	{
+	public:
+		static QueryPlan Explain(const WindowEnumerator<Enum, Aggregator>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Window", enumerator, enumerator.Source());
+
+			plan.memory = enumerator.WindowSize() * sizeof(typename Enum::value_type);
+			plan.notes.push_back("ring buffer with an incremental aggregator (amortized O(1) per object)");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<MemoizeEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const MemoizeEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Memoize", enumerator, enumerator.Source());
+
+			plan.memory = BufferSize(plan.cardinality, sizeof(typename Enum::value_type));
+			plan.notes.push_back("the input runs once; later enumerations replay a shared buffer");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<ProfileEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const ProfileEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainQuery(enumerator.Source());
+			plan.notes.push_back("profiled, so it is not fused with neighbouring stages");
+
+			return plan;
+		}
+	};
+
+	template <typename Type, typename Container>
+	class QueryExplainer<ContainerEnumerator<Type, Container>>
+	{
+	public:
+		static QueryPlan Explain(const ContainerEnumerator<Type, Container>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = IsOrderedContainer<Container>::value ? "Source: ordered container" : "Source: unordered container";
+			plan.cardinality = enumerator.Size();
+			plan.notes.push_back(IsOrderedContainer<Container>::value ? "Contains and Count use the container's lookups; Last reads rbegin" :
+				"Contains and Count use the container's lookups; Partition splits it by bucket ranges");
+
+			return plan;
+		}
+	};
+
+	template <typename Type, typename Container>
+	class QueryExplainer<BucketEnumerator<Type, Container>>
+	{
+	public:
+		static QueryPlan Explain(const BucketEnumerator<Type, Container>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "Source: buckets [" + std::to_string(enumerator.FirstBucket()) + ", " + std::to_string(enumerator.LastBucket()) + ") of an unordered container";
+			plan.notes.push_back("one part of Partition; parts can run in parallel");
+
+			return plan;
+		}
+	};
+
+	template <typename Table, bool IsFiltered>
+	class QueryExplainer<TableEnumerator<Table, IsFiltered>>
+	{
+	public:
+		static QueryPlan Explain(const TableEnumerator<Table, IsFiltered>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "Source: column table";
+
+			if (IsFiltered)
+			{
+				plan.cardinality = enumerator.Source().Size();
+				plan.isUpperBound = true;
+				plan.notes.push_back(std::to_string(enumerator.FilterCount()) + " column filter(s) select the rows once per enumeration, before any row is rebuilt");
+			}
+			else
+			{
+				plan.cardinality = enumerator.Size();
+			}
+
+			plan.notes.push_back("rows are rebuilt from the columns only when enumerated");
+
+			return plan;
+		}
+	};
+
+	template <typename Table, typename Type>
+	class QueryExplainer<TableColumnEnumerator<Table, Type>>
+	{
+	public:
+		static QueryPlan Explain(const TableColumnEnumerator<Table, Type>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.name = "Source: column table column";
+			plan.notes.push_back("gathered at the rows selected by " + std::to_string(enumerator.FilterCount()) + " column filter(s)");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<SortedEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const SortedEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainQuery(enumerator.Source());
+			plan.notes.push_back("objects known to be sorted");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<TakeEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const TakeEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Take", enumerator, enumerator.Source());
+
+			if (plan.cardinality == UnknownSize || enumerator.Count() < plan.cardinality)
+			{
+				plan.cardinality = enumerator.Count();
+				plan.isUpperBound = true;
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<SkipEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const SkipEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Skip", enumerator, enumerator.Source());
+
+			if (IsContiguousEnumerator<Enum>::value)
+			{
+				plan.notes.push_back("skips by advancing the contiguous source");
+			}
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<AdjacentDistinctEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const AdjacentDistinctEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainStage("Distinct", enumerator, enumerator.Source());
+			plan.notes.push_back("sorted input: compares neighbours, no set");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum>
+	class QueryExplainer<BoundEnumerator<Enum>>
+	{
+	public:
+		static QueryPlan Explain(const BoundEnumerator<Enum>& enumerator)
+		{
+			QueryPlan plan = ExplainStage(enumerator.IsEqualRange() ? "EqualRange" : "LowerBound", enumerator, enumerator.Source());
+			plan.notes.push_back(IsContiguousEnumerator<Enum>::value ? "binary search over the contiguous source" : "linear scan that stops past the value");
+
+			return plan;
+		}
+	};
+
+	// Set operations are bounded by their inputs: Union by their sum, Intersect by the smaller, Except by the first
+	template <SetOperation Operation>
+	void ExplainSetOperation(QueryPlan& plan)
+	{
+		const QueryPlan& first = plan.inputs.front();
+		const QueryPlan& second = plan.inputs.back();
+
+		plan.name = (Operation == SetOperation::Union) ? "Union" : (Operation == SetOperation::Intersect) ? "Intersect" : "Except";
+		plan.isUpperBound = true;
+
+		if (Operation == SetOperation::Union)
+		{
+			plan.cardinality = (first.cardinality == UnknownSize || second.cardinality == UnknownSize) ?
+				UnknownSize : first.cardinality + second.cardinality;
+		}
+		else if (Operation == SetOperation::Intersect)
+		{
+			plan.cardinality = std::min(first.cardinality, second.cardinality);
+		}
+		else
+		{
+			plan.cardinality = first.cardinality;
+		}
+	}
+
+	template <typename Enum, typename Enum2, SetOperation Operation>
+	class QueryExplainer<SetOperationEnumerator<Enum, Enum2, Operation>>
+	{
+	public:
+		static QueryPlan Explain(const SetOperationEnumerator<Enum, Enum2, Operation>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.inputs.push_back(ExplainQuery(enumerator.First()));
+			plan.inputs.push_back(ExplainQuery(enumerator.Second()));
+			ExplainSetOperation<Operation>(plan);
+
+			plan.memory = BufferSize(plan.cardinality, sizeof(typename Enum::value_type) + 2 * sizeof(void*));
+			plan.notes.push_back(IsHashable<typename Enum::value_type>::value ? "hash set lookups" : "ordered set lookups (the type has no std::hash)");
+
+			return plan;
+		}
+	};
+
+	template <typename Enum, typename Enum2, SetOperation Operation>
+	class QueryExplainer<MergeEnumerator<Enum, Enum2, Operation>>
+	{
+	public:
+		static QueryPlan Explain(const MergeEnumerator<Enum, Enum2, Operation>& enumerator)
+		{
+			QueryPlan plan;
+
+			plan.inputs.push_back(ExplainQuery(enumerator.First()));
+			plan.inputs.push_back(ExplainQuery(enumerator.Second()));
+			ExplainSetOperation<Operation>(plan);
+
+			plan.notes.push_back("linear merge of sorted inputs");
+
+			return plan;
+		}
+	};
+
+	// Standard range views are taken by value (see From(View) below) rather than as containers
+	template <typename Container>
+	struct IsRangesView : std::false_type { };
+
+#if defined(__cpp_lib_ranges)
+	template <typename Container>
+		requires std::ranges::view<Container>
+	struct IsRangesView<Container> : std::true_type { };
+#endif
+
+	// From
+	template <typename Type, typename Iter>
+	LinqObject<IteratorEnumerator<Type, Iter>> From(Iter begin, Iter end)
+	{
+		return IteratorEnumerator<Type, Iter>(begin, end);
+	}
+
+	template <typename Type, typename Iter>
+	LinqObject<Enumerator<Type, std::pair<Iter, std::size_t>>> From(Iter begin, std::size_t length)
+	{
+		return Enumerator<Type, std::pair<Iter, std::size_t>>([=](std::pair<Iter, std::size_t>& pair) -> std::optional<Type>
+		{
+			if (pair.second == length)
+			{
+				return std::nullopt;
+			}
+
+			pair.second++;
+			return Type(*(pair.first++));
+		}, std::make_pair(begin, std::size_t(0)));
+	}
+
+	template <typename Type, int N>
+	auto From(Type (&array)[N])
+		-> decltype(From<Type>(array, array + N))
+	{
+		return From<Type>(array, array + N);
+	}
+
+	template <template <class> class Container, class Type, typename = typename std::enable_if<!IsRangesView<Container<Type>>::value && !IsAssociativeContainer<Container<Type>>::value>::type>
+	auto From(const Container<Type>& container)
+		-> decltype(From<Type>(std::begin(container), std::end(container)))
+	{
+		return From<Type>(std::begin(container), std::end(container));
+	}
+
+	// For Span
+	template <typename Type>
+	auto From(const Span<Type>& span)
+		-> decltype(From<typename std::remove_const<Type>::type>(span.begin(), span.end()))
+	{
+		return From<typename std::remove_const<Type>::type>(span.begin(), span.end());
+	}
+
+	// For std::list, std::vector, std::dequeue
+	template<template<class, class> class V, typename T, typename U, typename = typename std::enable_if<!IsRangesView<V<T, U>>::value && !IsAssociativeContainer<V<T, U>>::value>::type>
+	auto From(const V<T, U>& container)
+		-> decltype(From<T>(std::begin(container), std::end(container)))
+	{
+		return From<T>(std::begin(container), std::end(container));
+	}
+
+	// For other containers with three template parameters (e.g. std::basic_string)
+	template <template <class, class, class> class V, typename T, typename S, typename U, typename = typename std::enable_if<!IsAssociativeContainer<V<T, S, U>>::value>::type>
+	auto From(const V<T, S, U>& container)
+		-> decltype(From<T>(std::begin(container), std::end(container)))
+	{
+		return From<T>(std::begin(container), std::end(container));
+	}
+
+	// For other containers with four template parameters
+	template <template <class, class, class, class> class V, typename K, typename T, typename S, typename U, typename = typename std::enable_if<!IsAssociativeContainer<V<K, T, S, U>>::value>::type>
+	auto From(const V<K, T, S, U>& container)
+		-> decltype(From<std::pair<K, T>>(std::begin(container), std::end(container)))
+	{
+		return From<std::pair<K, T>>(std::begin(container), std::end(container));
+	}
+
+	// For std::set, std::map and their multi and unordered variants (the source keeps a reference to the container)
+	template <typename Container, typename = typename std::enable_if<IsAssociativeContainer<Container>::value>::type>
+	LinqObject<ContainerEnumerator<typename ContainerValue<Container>::type, Container>> From(const Container& container)
+	{
+		return ContainerEnumerator<typename ContainerValue<Container>::type, Container>(container);
+	}
+
+	// For ColumnTable (rows are rebuilt only when they are enumerated)
+	template <typename Row, auto... Members>
+	LinqObject<TableEnumerator<ColumnTable<Row, Members...>, false>> From(const ColumnTable<Row, Members...>& table)
+	{
+		return TableEnumerator<ColumnTable<Row, Members...>, false>(table);
+	}
+
+	// For std::array
+	template <template <class, size_t> class V, typename T, size_t L>
+	auto From(const V<T, L>& container)
+		-> decltype(From<T>(container.data(), container.data() + L))
+	{
+		return From<T>(container.data(), container.data() + L);
+	}
+
+	// For Channel (consumes the channel until it is closed and drained)
+	template <typename Type>
+	LinqObject<ChannelEnumerator<Type>> From(Channel<Type>& channel)
+	{
+		return ChannelEnumerator<Type>(channel);
+	}
+
+#if defined(__cpp_lib_ranges)
+	// For std::ranges views (lazy; the view is copied, not its objects)
+	template <typename View>
+		requires std::ranges::view<View> && std::ranges::input_range<View> && std::copy_constructible<View>
+	LinqObject<ViewEnumerator<View>> From(View view)
+	{
+		return ViewEnumerator<View>(std::move(view));
+	}
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	// For coroutines (the factory is called again for every enumeration of the query)
+	template <typename Func, typename Type = typename std::decay<decltype(std::declval<Func&>()().Current())>::type>
+	LinqObject<GeneratorEnumerator<Type, Func>> FromGenerator(Func factory)
+	{
+		return GeneratorEnumerator<Type, Func>(std::move(factory));
+	}
+
+	// For a running coroutine (single pass)
+	template <typename Type>
+	LinqObject<GeneratorEnumerator<Type>> FromGenerator(Generator<Type> generator)
+	{
+		return GeneratorEnumerator<Type>(std::move(generator));
+	}
+#endif
+
+	// Zip (any number of sources)
+	template <typename Func, typename... Enums>
+	LinqObject<ZipEnumerator<Func, Enums...>> Zip(Func transform, const LinqObject<Enums>&... sources)
+	{
+		return ZipEnumerator<Func, Enums...>(transform, sources.m_enumerator...);
+	}
+
+	// ConcatAll
+	template <typename... Enums>
+	LinqObject<ConcatEnumerator<Enums...>> ConcatAll(const LinqObject<Enums>&... sources)
+	{
+		return ConcatEnumerator<Enums...>(sources.m_enumerator...);
+	}
+
+	template <typename Enum>
+	LinqObject<ConcatRangeEnumerator<Enum>> ConcatAll(const std::vector<LinqObject<Enum>>& sources)
+	{
+		std::vector<Enum> enumerators;
+		enumerators.reserve(sources.size());
+
+		for (const LinqObject<Enum>& source : sources)
+		{
+			enumerators.emplace_back(source.m_enumerator);
+		}
+
+		return ConcatRangeEnumerator<Enum>(enumerators);
+	}
+
+	// Repeat
+	template <typename Type>
+	LinqObject<RepeatEnumerator<Type>> Repeat(Type value, std::size_t count)
+	{
+		return RepeatEnumerator<Type>(value, count);
+	}
+
+	// Range (objects begin, begin + step, ... below end; empty unless step is positive)
+	template <typename Type>
+	ArithmeticLinqObject<Type> Range(Type begin, Type end, Type step)
+	{
+		std::size_t count = 0;
+
+		if (begin < end && Type() < step)
+		{
+			if constexpr (std::is_integral<Type>::value)
+			{
+				// end - begin in the unsigned type of the same width is exact even across the whole range
+				using Offset = typename OffsetType<Type>::type;
+
+				count = static_cast<std::size_t>((static_cast<Offset>(end) - static_cast<Offset>(begin) - 1) / static_cast<Offset>(step)) + 1;
+			}
+			else
+			{
+				count = static_cast<std::size_t>(std::ceil((end - begin) / step));
+
+				while (count > 0 && !(static_cast<Type>(begin + static_cast<Type>(count - 1) * step) < end))
+				{
+					--count;
+				}
+			}
+		}
+
+		return ArithmeticEnumerator<Type>(begin, step, count);
+	}
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+	// Task Result (storage for the value a task returns)
+	template <typename Type>
+	class TaskResult
+	{
+	public:
+		void return_value(Type value)
+		{
+			m_result.emplace(std::move(value));
+		}
+
+		Type TakeResult()
+		{
+			return std::move(*m_result);
+		}
+
+	private:
+		std::optional<Type> m_result;
+	};
+
+	template <>
+	class TaskResult<void>
+	{
+	public:
+		void return_void()
+		{
+
+		}
+
+		void TakeResult()
+		{
+
+		}
+	};
+
+	// Task (coroutine producing one result, started when it is awaited or run on an EventLoop)
+	// Completing a task resumes the coroutine awaiting it directly, without a trip through the loop.
+	template <typename Type>
+	class Task
+	{
+		friend class EventLoop;
+
+	public:
+		class promise_type;
+
+		class FinalAwaiter
+		{
+		public:
+			bool await_ready() const noexcept
+			{
+				return false;
+			}
+
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+			{
+				std::coroutine_handle<> continuation = handle.promise().m_continuation;
+				return continuation ? continuation : std::noop_coroutine();
+			}
+
+			void await_resume() const noexcept
+			{
+
+			}
+		};
+
+		class promise_type : public TaskResult<Type>
+		{
+		public:
+			Task get_return_object()
+			{
+				return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+			}
+
+			std::suspend_always initial_suspend() noexcept
+			{
+				return {};
+			}
+
+			FinalAwaiter final_suspend() noexcept
+			{
+				return {};
+			}
+
+			void unhandled_exception()
+			{
+				m_exception = std::current_exception();
+			}
+
+			static void* operator new(std::size_t size)
+			{
+				return CoroutineFrameAllocator::Allocate(size);
+			}
+
+			static void operator delete(void* frame, std::size_t size)
+			{
+				CoroutineFrameAllocator::Deallocate(frame, size);
+			}
+
+			std::coroutine_handle<> m_continuation;
+			std::exception_ptr m_exception;
+		};
+
+		Task(Task&& other) noexcept :
+			m_handle(std::exchange(other.m_handle, nullptr))
+		{
+
+		}
+
+		Task& operator=(Task other) noexcept
+		{
+			std::swap(m_handle, other.m_handle);
+			return *this;
+		}
+
+		~Task()
+		{
+			if (m_handle)
+			{
+				m_handle.destroy();
+			}
+		}
+
+		bool await_ready() const noexcept
+		{
+			return false;
+		}
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+		{
+			m_handle.promise().m_continuation = awaiting;
+			return m_handle;
+		}
+
+		Type await_resume()
+		{
+			return Result();
+		}
+
+	private:
+		explicit Task(std::coroutine_handle<promise_type> handle) :
+			m_handle(handle)
+		{
+
+		}
+
+		Type Result()
+		{
+			if (m_handle.promise().m_exception)
+			{
+				std::rethrow_exception(std::exchange(m_handle.promise().m_exception, nullptr));
+			}
+
+			return m_handle.promise().TakeResult();
+		}
+
+		std::coroutine_handle<promise_type> m_handle;
+	};
+
+	// Event Loop (single-threaded scheduler for tasks and the channels between them)
+	class EventLoop
+	{
+	public:
+		void Post(std::coroutine_handle<> handle)
+		{
+			m_ready.push_back(handle);
+		}
+
+		// Runs task alongside the rest of the work; its frame is kept until the loop is destroyed
+		void Spawn(Task<void> task)
+		{
+			Post(task.m_handle);
+			m_spawned.push_back(std::move(task));
+		}
+
+		// Resumes coroutines until none is ready, then reports the failure of any spawned task
+		void Run()
+		{
+			while (!m_ready.empty())
+			{
+				std::coroutine_handle<> handle = m_ready.front();
+				m_ready.pop_front();
+				handle.resume();
+			}
+
+			for (Task<void>& task : m_spawned)
+			{
+				if (task.m_handle.done())
+				{
+					task.Result();
+				}
+			}
+		}
+
+		template <typename Type>
+		Type Run(Task<Type> task)
+		{
+			Post(task.m_handle);
+			Run();
+
+			if (!task.m_handle.done())
+			{
+				throw std::logic_error("CppLinq::EventLoop: the task waits for work that is never posted");
+			}
+
+			return task.Result();
+		}
+
+	private:
+		std::deque<std::coroutine_handle<>> m_ready;
+		std::vector<Task<void>> m_spawned;
+	};
+
+	// Async Channel (bounded queue from any number of producers to one consumer)
+	// A sender waits while capacity objects are queued, which holds a fast producer back to the
+	// pace of the consumer. Closing rejects further sends; queued objects are still received.
+	template <typename Type>
+	class AsyncChannel
+	{
+		class SendAwaiter
+		{
+			friend class AsyncChannel;
+
+		public:
+			SendAwaiter(AsyncChannel& channel, Type object) :
+				m_channel(channel), m_object(std::move(object)), m_isAccepted(true)
+			{
+
+			}
+
+			bool await_ready()
+			{
+				if (m_channel.m_isClosed)
+				{
+					m_isAccepted = false;
+					return true;
+				}
+
+				if (m_channel.m_objects.size() < m_channel.m_capacity)
+				{
+					m_channel.Push(std::move(m_object));
+					return true;
+				}
+
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				m_handle = handle;
+				m_channel.m_senders.push_back(this);
+			}
+
+			// False when the channel was closed before the object could be queued
+			bool await_resume() const
+			{
+				return m_isAccepted;
+			}
+
+		private:
+			AsyncChannel& m_channel;
+			Type m_object;
+			std::coroutine_handle<> m_handle;
+			bool m_isAccepted;
+		};
+
+		class ReceiveAwaiter
+		{
+		public:
+			ReceiveAwaiter(AsyncChannel& channel) :
+				m_channel(channel)
+			{
+
+			}
+
+			bool await_ready() const
+			{
+				return !m_channel.m_objects.empty() || m_channel.m_isClosed;
+			}
+
+			void await_suspend(std::coroutine_handle<> handle)
+			{
+				m_channel.m_receiver = handle;
+			}
+
+			// Nothing once the channel is closed and drained
+			std::optional<Type> await_resume()
+			{
+				return m_channel.Pop();
+			}
+
+		private:
+			AsyncChannel& m_channel;
+		};
+
+		void Push(Type&& object)
+		{
+			m_objects.push_back(std::move(object));
+
+			if (m_receiver)
+			{
+				m_loop.Post(std::exchange(m_receiver, nullptr));
+			}
+		}
+
+		std::optional<Type> Pop()
+		{
+			if (m_objects.empty())
+			{
+				return std::nullopt;
+			}
+
+			std::optional<Type> object(std::move(m_objects.front()));
+			m_objects.pop_front();
+
+			if (!m_senders.empty())
+			{
+				SendAwaiter* sender = m_senders.front();
+				m_senders.pop_front();
+				m_objects.push_back(std::move(sender->m_object));
+				m_loop.Post(sender->m_handle);
+			}
+
+			return object;
+		}
+
+	public:
+		AsyncChannel(EventLoop& loop, std::size_t capacity) :
+			m_loop(loop), m_capacity(std::max<std::size_t>(capacity, 1)), m_isClosed(false)
+		{
+
+		}
+
+		AsyncChannel(const AsyncChannel&) = delete;
+		AsyncChannel& operator=(const AsyncChannel&) = delete;
+
+		SendAwaiter Send(Type object)
+		{
+			return SendAwaiter(*this, std::move(object));
+		}
+
+		ReceiveAwaiter Receive()
+		{
+			return ReceiveAwaiter(*this);
+		}
+
+		void Close()
+		{
+			m_isClosed = true;
+
+			if (m_receiver)
+			{
+				m_loop.Post(std::exchange(m_receiver, nullptr));
+			}
+
+			for (SendAwaiter* sender : m_senders)
+			{
+				sender->m_isAccepted = false;
+				m_loop.Post(sender->m_handle);
+			}
+
+			m_senders.clear();
+		}
+
+		// Number of objects queued
+		std::size_t Size() const
+		{
+			return m_objects.size();
+		}
+
+		std::size_t Capacity() const
+		{
+			return m_capacity;
+		}
+
+	private:
+		EventLoop& m_loop;
+		std::size_t m_capacity;
+		std::deque<Type> m_objects;
+		std::deque<SendAwaiter*> m_senders;
+		std::coroutine_handle<> m_receiver;
+		bool m_isClosed;
+	};
+
+	// Channel Async Enumerator
+	template <typename Type>
+	class ChannelAsyncEnumerator
+	{
+	public:
+		using value_type = Type;
+
+		ChannelAsyncEnumerator(AsyncChannel<Type>& channel) :
+			m_channel(&channel)
+		{
+
+		}
+
+		Task<std::optional<Type>> NextAsync()
+		{
+			co_return co_await m_channel->Receive();
+		}
+
+	private:
+		AsyncChannel<Type>* m_channel;
+	};
+
+	// Linq Async Enumerator (synchronous pipeline pulled from asynchronous code)
+	template <typename Enum>
+	class LinqAsyncEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		LinqAsyncEnumerator(Enum source) :
+			m_source(source)
+		{
+
+		}
+
+		Task<std::optional<value_type>> NextAsync()
+		{
+			co_return CppLinq::TryNextObject(m_source);
+		}
+
+	private:
+		Enum m_source;
+	};
+
+	// Where Async Enumerator
+	template <typename Enum, typename Func>
+	class WhereAsyncEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		WhereAsyncEnumerator(Enum source, Func predicate) :
+			m_source(source), m_predicate(predicate)
+		{
+
+		}
+
+		Task<std::optional<value_type>> NextAsync()
+		{
+			while (true)
+			{
+				std::optional<value_type> object = co_await m_source.NextAsync();
+
+				if (!object || m_predicate(*object))
+				{
+					co_return object;
+				}
+			}
+		}
+
+	private:
+		Enum m_source;
+		Func m_predicate;
+	};
+
+	// Select Async Enumerator
+	template <typename Enum, typename Func>
+	class SelectAsyncEnumerator
+	{
+	public:
+		using value_type = typename std::decay<decltype(std::declval<Func&>()(std::declval<typename Enum::value_type&>()))>::type;
+
+		SelectAsyncEnumerator(Enum source, Func transform) :
+			m_source(source), m_transform(transform)
+		{
+
+		}
+
+		Task<std::optional<value_type>> NextAsync()
+		{
+			std::optional<typename Enum::value_type> object = co_await m_source.NextAsync();
+
+			if (!object)
+			{
+				co_return std::nullopt;
+			}
+
+			co_return m_transform(*object);
+		}
+
+	private:
+		Enum m_source;
+		Func m_transform;
+	};
+
+	// Take Async Enumerator (stops pulling from the source after count objects)
+	template <typename Enum>
+	class TakeAsyncEnumerator
+	{
+	public:
+		using value_type = typename Enum::value_type;
+
+		TakeAsyncEnumerator(Enum source, std::size_t count) :
+			m_source(source), m_count(count)
+		{
+
+		}
+
+		Task<std::optional<value_type>> NextAsync()
+		{
+			if (m_count == 0)
+			{
+				co_return std::nullopt;
+			}
+
+			--m_count;
+			co_return co_await m_source.NextAsync();
+		}
+
+	private:
+		Enum m_source;
+		std::size_t m_count;
+	};
+
+	// Async Linq Object (pipeline pulled through awaitable NextAsync calls)
+	// Terminals return a Task that runs the query on a copy of the pipeline when it is awaited.
+	template <typename Enum>
+	class AsyncLinqObject
+	{
+		using Type = typename Enum::value_type;
+
+		static Task<std::size_t> CountInternal(Enum en)
+		{
+			std::size_t count = 0;
+
+			while (co_await en.NextAsync())
+			{
+				++count;
+			}
+
+			co_return count;
+		}
+
+		static Task<Type> SumInternal(Enum en)
+		{
+			Type sum = Type();
+
+			for (std::optional<Type> object = co_await en.NextAsync(); object; object = co_await en.NextAsync())
+			{
+				sum += *object;
+			}
+
+			co_return sum;
+		}
+
+		static Task<std::vector<Type>> ToVectorInternal(Enum en)
+		{
+			std::vector<Type> result;
+
+			for (std::optional<Type> object = co_await en.NextAsync(); object; object = co_await en.NextAsync())
+			{
+				result.push_back(std::move(*object));
+			}
+
+			co_return result;
+		}
+
+		template <typename Action>
+		static Task<void> ForeachInternal(Enum en, Action action)
+		{
+			for (std::optional<Type> object = co_await en.NextAsync(); object; object = co_await en.NextAsync())
+			{
+				action(*object);
+			}
+		}
+
+	public:
+		Enum m_enumerator;
+
+		using value_type = typename Enum::value_type;
+
+		AsyncLinqObject(Enum enumerator) : m_enumerator(enumerator)
+		{
+
+		}
+
+		Task<std::optional<Type>> NextAsync()
+		{
+			return m_enumerator.NextAsync();
+		}
+
+		// Where
+		template <typename Func>
+		AsyncLinqObject<WhereAsyncEnumerator<Enum, Func>> Where(Func predicate) const
+		{
+			return WhereAsyncEnumerator<Enum, Func>(m_enumerator, predicate);
+		}
+
+		// Select
+		template <typename Func>
+		AsyncLinqObject<SelectAsyncEnumerator<Enum, Func>> Select(Func transform) const
+		{
+			return SelectAsyncEnumerator<Enum, Func>(m_enumerator, transform);
+		}
+
+		// Take
+		AsyncLinqObject<TakeAsyncEnumerator<Enum>> Take(std::size_t count) const
+		{
+			return TakeAsyncEnumerator<Enum>(m_enumerator, count);
+		}
+
+		// Count
+		Task<std::size_t> Count() const
+		{
+			return CountInternal(m_enumerator);
+		}
+
+		// Sum
+		Task<Type> Sum() const
+		{
+			return SumInternal(m_enumerator);
+		}
+
+		// Foreach
+		template <typename Action>
+		Task<void> Foreach(Action action) const
+		{
+			return ForeachInternal(m_enumerator, action);
+		}
+
+		// Export to vector
+		Task<std::vector<Type>> ToVector() const
+		{
+			return ToVectorInternal(m_enumerator);
+		}
+	};
+
+	// FromAsync
+	template <typename Type>
+	AsyncLinqObject<ChannelAsyncEnumerator<Type>> FromAsync(AsyncChannel<Type>& channel)
+	{
+		return ChannelAsyncEnumerator<Type>(channel);
+	}
+
+	template <typename Enum>
+	AsyncLinqObject<LinqAsyncEnumerator<Enum>> FromAsync(const LinqObject<Enum>& source)
+	{
+		return LinqAsyncEnumerator<Enum>(source.m_enumerator);
+	}
+#endif
+
+	// Static Linq Object (compile-time evaluation over fixed-capacity arrays)
+	// Holds up to N objects by value so every operator can run in a constexpr context.
+	template <typename Type, std::size_t N>
+	class StaticLinqObject
+	{
+		template <typename Type2, std::size_t N2>
+		friend class StaticLinqObject;
+
+		template <typename Func, typename Arg>
+		static auto GetReturnType(Func* func = nullptr, Arg* arg1 = nullptr)
+			-> decltype((*func)(*arg1));
+
+		std::array<Type, N> m_objects;
+		std::size_t m_count;
+
+	public:
+		using value_type = Type;
+
+		constexpr StaticLinqObject() :
+			m_objects(), m_count(0)
+		{
+
+		}
+
+		constexpr StaticLinqObject(const Type (&array)[N]) :
+			m_objects(), m_count(N)
+		{
+			for (std::size_t i = 0; i < N; ++i)
+			{
+				m_objects[i] = array[i];
+			}
+		}
+
+		constexpr const Type* begin() const
+		{
+			return m_objects.data();
+		}
+
+		constexpr const Type* end() const
+		{
+			return m_objects.data() + m_count;
+		}
+
+		// Select
+		template <typename Func>
+		constexpr StaticLinqObject<decltype(GetReturnType<Func, Type>()), N> Select(Func transform) const
+		{
+			StaticLinqObject<decltype(GetReturnType<Func, Type>()), N> result;
+
+			for (std::size_t i = 0; i < m_count; ++i)
+			{
+				result.m_objects[result.m_count++] = transform(m_objects[i]);
+			}
+
+			return result;
+		}
+
+		// Where
+		template <typename Func>
+		constexpr StaticLinqObject Where(Func predicate) const
+		{
+			StaticLinqObject result;
+
+			for (std::size_t i = 0; i < m_count; ++i)
+			{
+				if (predicate(m_objects[i]))
+				{
+					result.m_objects[result.m_count++] = m_objects[i];
+				}
+			}
+
+			return result;
+		}
+
+		// OrderBy (stable insertion sort)
+		template <typename Func>
+		constexpr StaticLinqObject OrderBy(Func transform) const
+		{
+			StaticLinqObject result = *this;
+
+			for (std::size_t i = 1; i < result.m_count; ++i)
+			{
+				Type object = result.m_objects[i];
+				std::size_t j = i;
+
+				for (; j > 0 && transform(object) < transform(result.m_objects[j - 1]); --j)
+				{
+					result.m_objects[j] = result.m_objects[j - 1];
+				}
+
+				result.m_objects[j] = object;
+			}
+
+			return result;
+		}
+
+		constexpr StaticLinqObject OrderBy() const
+		{
+			return OrderBy([](Type a) { return a; });
+		}
+
+		// Take
+		constexpr StaticLinqObject Take(std::size_t count) const
+		{
+			StaticLinqObject result = *this;
+			result.m_count = count < m_count ? count : m_count;
+
+			return result;
+		}
+
+		// Skip
+		constexpr StaticLinqObject Skip(std::size_t count) const
+		{
+			StaticLinqObject result;
+
+			for (std::size_t i = count; i < m_count; ++i)
+			{
+				result.m_objects[result.m_count++] = m_objects[i];
+			}
+
+			return result;
+		}
+
+		// Reverse
+		constexpr StaticLinqObject Reverse() const
+		{
+			StaticLinqObject result;
+
+			for (std::size_t i = m_count; i > 0; --i)
+			{
+				result.m_objects[result.m_count++] = m_objects[i - 1];
+			}
+
+			return result;
+		}
+
+		// Distinct
+		constexpr StaticLinqObject Distinct() const
+		{
+			StaticLinqObject result;
+
+			for (std::size_t i = 0; i < m_count; ++i)
+			{
+				if (!result.Contains(m_objects[i]))
+				{
+					result.m_objects[result.m_count++] = m_objects[i];
+				}
+			}
+
+			return result;
+		}
+
+		// Sum
+		constexpr Type Sum() const
+		{
+			Type result = Type();
+
+			for (std::size_t i = 0; i < m_count; ++i)
+			{
+				result += m_objects[i];
+			}
+
+			return result;
+		}
+
+		// Count
+		template <typename Func>
+		constexpr std::size_t Count(Func predicate) const
+		{
+			std::size_t count = 0;
+
+			for (std::size_t i = 0; i < m_count; ++i)
+			{
+				count += predicate(m_objects[i]) ? 1 : 0;
+			}
+
+			return count;
+		}
+
+		constexpr std::size_t Count() const
+		{
+			return m_count;
+		}
+
+		// Any
+		template <typename Func>
+		constexpr bool Any(Func predicate) const
+		{
+			for (std::size_t i = 0; i < m_count; ++i)
+			{
+				if (predicate(m_objects[i]))
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		// All
+		template <typename Func>
+		constexpr bool All(Func predicate) const
+		{
+			return !Any([=](Type a) { return !predicate(a); });
+		}
+
+		// Contains
+		constexpr bool Contains(const Type& value) const
+		{
+			return Any([&](Type a) { return value == a; });
+		}
+
+		// Max
+		constexpr Type Max() const
+		{
+			Type result = ElementAt(0);
+
+			for (std::size_t i = 1; i < m_count; ++i)
+			{
+				result = result < m_objects[i] ? m_objects[i] : result;
+			}
+
+			return result;
+		}
+
+		// Min
+		constexpr Type Min() const
+		{
+			Type result = ElementAt(0);
+
+			for (std::size_t i = 1; i < m_count; ++i)
+			{
+				result = m_objects[i] < result ? m_objects[i] : result;
+			}
+
+			return result;
+		}
+
+		// ElementAt
+		constexpr Type ElementAt(std::size_t index) const
+		{
+			return (index < m_count) ? m_objects[index] : throw EnumeratorEndException();
+		}
+
+		// First
+		constexpr Type First() const
+		{
+			return ElementAt(0);
+		}
+
+		// Last
+		constexpr Type Last() const
+		{
+			return (m_count > 0) ? m_objects[m_count - 1] : throw EnumeratorEndException();
+		}
+
+		// Export to std::array (throws std::length_error unless Count() is M, a compile error in constant evaluation)
+		template <std::size_t M>
+		constexpr std::array<Type, M> ToArray() const
+		{
+			std::array<Type, M> result{};
+
+			if (m_count != M)
+			{
+				throw std::length_error("ToArray: the object count differs from the array size");
+			}
+
+			for (std::size_t i = 0; i < M; ++i)
+			{
+				result[i] = m_objects[i];
+			}
+
+			return result;
+		}
+	};
+
+	// StaticFrom
+	template <typename Type, std::size_t N>
+	constexpr StaticLinqObject<Type, N> StaticFrom(const Type (&array)[N])
+	{
+		return StaticLinqObject<Type, N>(array);
+	}
+
+	// StaticRepeat
+	template <std::size_t N, typename Type>
+	constexpr StaticLinqObject<Type, N> StaticRepeat(Type value)
+	{
+		Type array[N] = {};
+
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			array[i] = value;
+		}
+
+		return StaticLinqObject<Type, N>(array);
+	}
+
+	// StaticRange (at most N objects)
+	template <std::size_t N, typename Type>
+	constexpr StaticLinqObject<Type, N> StaticRange(Type begin, Type end, Type step)
+	{
+		Type array[N] = {};
+		std::size_t count = 0;
+
+		for (Type value = begin; count < N && value < end; value += step)
+		{
+			array[count++] = value;
+		}
+
+		return StaticLinqObject<Type, N>(array).Take(count);
 	}
 }
 
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(Explain, OperatorTree)
+{
+	std::vector<int> src = { 5, 3, 8, 1, 9, 2 };
+
+	auto plan = CppLinq::From(src)
+		.Where([](int a) { return a > 1; })
+		.Where([](int a) { return a < 9; })
+		.OrderBy()
+		.Select([](int a) { return a * 2; })
+		.Explain();
+
+	EXPECT_EQ("Select", plan.name);
+	ASSERT_EQ(1u, plan.inputs.size());
+
+	const CppLinq::QueryPlan& orderBy = plan.inputs[0];
+	EXPECT_EQ("OrderBy", orderBy.name);
+	EXPECT_TRUE(orderBy.isPipelineBreaker);
+	EXPECT_EQ(6u, orderBy.cardinality);
+	EXPECT_TRUE(orderBy.isUpperBound);
+	EXPECT_EQ(6 * sizeof(std::pair<int, int>), orderBy.memory);
+
+	const CppLinq::QueryPlan& where = orderBy.inputs[0];
+	EXPECT_EQ("Where", where.name);
+	EXPECT_TRUE(where.isUpperBound);
+	EXPECT_EQ("adjacent Where clauses fused into one predicate", where.notes[0]);
+	EXPECT_EQ("Source: contiguous range", where.inputs[0].name);
+}
+
+TEST(Explain, Text)
+{
+	std::list<int> src = { 1, 2, 3 };
+
+	std::string text = CppLinq::From(src).Concat(CppLinq::Range(0, 4, 1)).Concat(CppLinq::From(src)).Reverse().Take(2).Explain().ToString();
+
+	EXPECT_NE(std::string::npos, text.find("Take [at most 2 objects]"));
+	EXPECT_NE(std::string::npos, text.find("  Reverse (pipeline breaker) (buffers an unknown amount)"));
+	EXPECT_NE(std::string::npos, text.find("    Concat\n"));
+	EXPECT_NE(std::string::npos, text.find("Concat chain flattened into one cursor over 3 parts"));
+	EXPECT_NE(std::string::npos, text.find("      Source: Range [4 objects]"));
+	EXPECT_NE(std::string::npos, text.find("      Source: iterator range\n"));
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <string>
+
+namespace
+{
+	CppLinq::Generator<long long> Fibonacci()
+	{
+		long long a = 0, b = 1;
+
+		while (true)
+		{
+			co_yield a;
+			b = std::exchange(a, b) + b;
+		}
+	}
+
+	CppLinq::Generator<std::string> Split(std::string text, char separator)
+	{
+		std::size_t begin = 0;
+
+		for (std::size_t end = text.find(separator); end != std::string::npos; end = text.find(separator, begin))
+		{
+			co_yield text.substr(begin, end - begin);
+			begin = end + 1;
+		}
+
+		co_yield text.substr(begin);
+	}
+
+	CppLinq::Generator<int> Failing()
+	{
+		co_yield 1;
+		throw std::runtime_error("parse error");
+	}
+}
+
+TEST(Generator, InfiniteSource)
+{
+	long long ans[] = { 0, 1, 1, 2, 3, 5, 8, 13 };
+
+	auto dst = CppLinq::FromGenerator(Fibonacci).Take(8);
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(832040, CppLinq::FromGenerator(Fibonacci).Where([](long long a) { return a > 800000; }).First());
+}
+
+TEST(Generator, Parser)
+{
+	std::string ans[] = { "ab", "", "cde" };
+
+	auto dst = CppLinq::FromGenerator([] { return Split("ab,,cde", ','); });
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(3, dst.Count());
+	EXPECT_EQ(3, dst.Count());
+	EXPECT_EQ(2, CppLinq::FromGenerator(Split("x,y", ',')).Count());
+}
+
+TEST(Generator, CopyAssignment)
+{
+	auto dst = CppLinq::FromGenerator([] { return Fibonacci(); }).Skip(5);
+	auto copy = dst;
+
+	copy.NextObject();
+	copy = dst;
+
+	EXPECT_EQ(5, copy.First());
+
+	CppLinq::Generator<long long> generator = Fibonacci();
+	CppLinq::Generator<long long> moved = std::move(generator);
+
+	EXPECT_FALSE(generator.Next());
+	EXPECT_TRUE(moved.Next());
+}
+
+TEST(Generator, Exception)
+{
+	auto dst = CppLinq::FromGenerator(Failing);
+
+	EXPECT_EQ(1, dst.NextObject());
+	EXPECT_THROW(dst.NextObject(), std::runtime_error);
+}
+
+TEST(Generator, RecycledFrames)
+{
+	int sum = 0;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		sum += static_cast<int>(CppLinq::FromGenerator(Fibonacci).Take(3).Sum());
+	}
+
+	EXPECT_EQ(2000, sum);
+}
+#endif
\ No newline at end of file
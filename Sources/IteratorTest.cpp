@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <numeric>
+
+TEST(Iterator, RangeBasedFor)
+{
+	int src[] = { 1, 2, 3, 4, 5, 6 };
+	std::vector<int> ans = { 20, 40, 60 };
+	std::vector<int> dst;
+
+	for (int object : CppLinq::From(src).Where([](int a) { return a % 2 == 0; }).Select([](int a) { return a * 10; }))
+	{
+		dst.push_back(object);
+	}
+
+	EXPECT_EQ(ans, dst);
+}
+
+TEST(Iterator, ContiguousSource)
+{
+	std::vector<int> src = { 3, 1, 4, 1, 5 };
+	auto query = CppLinq::From(src);
+
+	EXPECT_EQ(src.data(), query.begin());
+	EXPECT_EQ(src.data() + src.size(), query.end());
+	EXPECT_EQ(14, std::accumulate(query.begin(), query.end(), 0));
+	EXPECT_EQ(5, *std::max_element(query.begin(), query.end()));
+}
+
+TEST(Iterator, Algorithms)
+{
+	std::list<int> src = { 3, 1, 4, 1, 5, 9, 2, 6 };
+	auto query = CppLinq::From(src).Select([](int a) { return a * 2; });
+
+	auto iter = query.begin();
+	EXPECT_EQ(6, *iter);
+	EXPECT_EQ(6, *iter++);
+	EXPECT_EQ(2, *iter);
+	EXPECT_TRUE(iter != CppLinq::LinqSentinel());
+
+	int sum = 0;
+
+	for (auto it = query.begin(); it != query.end(); ++it)
+	{
+		sum += *it;
+	}
+
+	EXPECT_EQ(62, sum);
+	EXPECT_TRUE(CppLinq::Range(0, 0, 1).begin() == CppLinq::Range(0, 0, 1).end());
+}
+
+TEST(Iterator, TryNextObject)
+{
+	auto query = CppLinq::Range(1, 3, 1).Reverse();
+
+	EXPECT_EQ(2, query.TryNextObject());
+	EXPECT_EQ(1, query.TryNextObject());
+	EXPECT_FALSE(query.TryNextObject().has_value());
+}
+
+TEST(Iterator, TryNextObjectOfIndexedStages)
+{
+	std::vector<int> src = { 1, 2, 3, 4, 1 };
+
+	auto takeWhile = CppLinq::From(src).TakeWhile([](int a) { return a < 2; });
+	auto skipWhile = CppLinq::From(src).SkipWhile([](int a) { return a < 4; });
+	auto distinct = CppLinq::From(src).Distinct([](int a) { return a % 3; });
+	auto fromLength = CppLinq::From<int>(src.begin(), 1);
+
+	EXPECT_EQ(1, takeWhile.TryNextObject());
+	EXPECT_FALSE(takeWhile.TryNextObject().has_value());
+	EXPECT_EQ(4, skipWhile.TryNextObject());
+	EXPECT_EQ(1, skipWhile.TryNextObject());
+	EXPECT_FALSE(skipWhile.TryNextObject().has_value());
+	EXPECT_EQ(3, distinct.Count());
+	EXPECT_EQ(1, fromLength.TryNextObject());
+	EXPECT_FALSE(fromLength.TryNextObject().has_value());
+	EXPECT_FALSE(fromLength.TryNextObject().has_value());
+}
+
+#if defined(__cpp_lib_ranges)
+TEST(Iterator, Ranges)
+{
+	std::vector<int> src = { 1, 2, 3, 4, 5, 6 };
+	auto query = CppLinq::From(src).Where([](int a) { return a > 2; });
+
+	static_assert(std::ranges::input_range<decltype(query)>);
+	static_assert(std::ranges::contiguous_range<decltype(CppLinq::From(src))>);
+
+	int sum = 0;
+
+	for (int object : query | std::views::transform([](int a) { return a * a; }))
+	{
+		sum += object;
+	}
+
+	EXPECT_EQ(86, sum);
+
+	int ans[] = { 4, 16, 36 };
+	auto dst = CppLinq::From(src | std::views::filter([](int a) { return a % 2 == 0; })).Select([](int a) { return a * a; });
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(6u, CppLinq::From(std::views::iota(0, 6)).m_enumerator.Size());
+	EXPECT_EQ(15, CppLinq::From(std::views::iota(0, 6)).Sum());
+
+	int rest[] = { 4, 6 };
+	auto evens = CppLinq::From(src | std::views::filter([](int a) { return a % 2 == 0; }));
+	auto copy = evens;
+
+	{
+		auto temp = evens;
+		temp.NextObject();
+		copy = temp;
+	}
+
+	IsEqualArray(copy, rest);
+	EXPECT_EQ(2, evens.NextObject());
+}
+#endif
\ No newline at end of file
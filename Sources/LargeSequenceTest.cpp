@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <cstdint>
+
+TEST(LargeSequence, RepeatCount)
+{
+	const std::size_t count = 5000000000ull;
+	auto rng = CppLinq::Repeat(7, count);
+
+	EXPECT_EQ(count, rng.Count());
+	EXPECT_EQ(5000000000ll, rng.LongCount());
+	EXPECT_EQ(count, rng.Select([](int a) { return a * 2; }).Count());
+	EXPECT_EQ(5u, rng.Take(5).Count());
+	EXPECT_EQ(count - 10, rng.Skip(10).Count());
+	EXPECT_EQ(3000000000ull, rng.Skip(10).Take(3000000000ull).Count());
+}
+
+TEST(LargeSequence, RangeBeyond32Bit)
+{
+	const std::int64_t end = 6000000000ll;
+	auto rng = CppLinq::Range(std::int64_t(0), end, std::int64_t(1));
+
+	EXPECT_EQ(6000000000ull, rng.Count());
+	EXPECT_EQ(6000000000ll, rng.LongCount());
+	EXPECT_EQ(5999999999ll, rng.Max());
+	EXPECT_EQ(5000000000ll, rng.Skip(5000000000ull).ElementAt(0));
+	EXPECT_EQ(2ull, rng.Skip(5999999998ull).Count());
+}
+
+TEST(LargeSequence, IndexedTake)
+{
+	int src[] = { 1, 2, 3, 4, 5 };
+	int ans[] = { 1, 2, 3 };
+
+	auto dst = CppLinq::From(src).Where([](int a) { return a > 0; }).Take(3);
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(3ll, dst.LongCount());
+	EXPECT_EQ(2ll, CppLinq::From(src).LongCount([](int a) { return a % 2 == 0; }));
+	EXPECT_EQ(3, CppLinq::From(src).Average([](int a) { return a; }));
+}
+
+TEST(LargeSequence, IterateBeyond32Bit)
+{
+	std::int64_t ans[] = { 4294967296ll, 4294967297ll, 4294967298ll, 4294967299ll, 4294967300ll };
+
+	auto rng = CppLinq::Range(std::int64_t(0), std::int64_t(4294967301ll), std::int64_t(1)).Skip(4294967296ull);
+	auto dst = rng.Where([](std::int64_t a) { return a > 0; });
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(5u, dst.Count());
+}
+
+TEST(LargeSequence, AverageWithoutOverflow)
+{
+	std::vector<int> src(4, 2000000000);
+
+	EXPECT_EQ(2000000000, CppLinq::Repeat(2000000000, 5).Average());
+	EXPECT_EQ(2000000000, CppLinq::From(src).Average());
+	EXPECT_EQ(2000000000, std::get<0>(CppLinq::From(src).AggregateMany<CppLinq::AggregateAverage>()));
+	EXPECT_EQ(-1, CppLinq::Range(-2000000000, 2000000000, 1).Average());
+
+	auto rng = CppLinq::Range(-2000000000, 2000000000, 1);
+
+	EXPECT_EQ(4000000000u, rng.Count());
+	EXPECT_EQ(1999999999, rng.Max());
+	EXPECT_TRUE(rng.Contains(1999999999));
+	EXPECT_EQ(1999999999, rng.Skip(3999999999u).First());
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(Memoize, RepeatedTerminals)
+{
+	int src[] = { 4, 8, 15, 16, 23, 42 };
+	int ans[] = { 16, 64, 225, 256, 529, 1764 };
+	int calls = 0;
+
+	auto dst = CppLinq::From(src).Select([&](int a) { ++calls; return a * a; }).Memoize();
+
+	EXPECT_EQ(0, calls);
+	EXPECT_EQ(6, dst.Count());
+	EXPECT_EQ(2854, dst.Sum());
+	EXPECT_EQ(1764, dst.Max());
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(6, calls);
+}
+
+TEST(Memoize, PartialPass)
+{
+	std::list<int> src = { 1, 2, 3, 4, 5 };
+	int calls = 0;
+
+	auto dst = CppLinq::From(src).Where([&](int a) { ++calls; return a % 2 == 1; }).Memoize();
+
+	EXPECT_EQ(1, dst.First());
+	EXPECT_EQ(1, calls);
+	EXPECT_EQ((std::vector<int>{ 1, 3, 5 }), dst.ToVector());
+	EXPECT_EQ(5, calls);
+	EXPECT_EQ(3, dst.m_enumerator.Size());
+}
+
+TEST(Memoize, ConcurrentReaders)
+{
+	std::atomic<int> calls(0);
+	auto dst = CppLinq::Range(0LL, 100000LL, 1LL).Select([&](long long a) { ++calls; return a * 2; }).Memoize();
+
+	std::vector<std::future<long long>> sums;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		sums.push_back(std::async(std::launch::async, [dst] { return dst.Sum(); }));
+	}
+
+	for (std::future<long long>& sum : sums)
+	{
+		EXPECT_EQ(9999900000LL, sum.get());
+	}
+
+	EXPECT_EQ(100000, calls.load());
+}
\ No newline at end of file
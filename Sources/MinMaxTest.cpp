@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <list>
+#include <string>
+
+TEST(MinMax, Ints)
+{
+	std::vector<int> src = { 4, 1, 7, 3, 9, 2, 8 };
+
+	auto rng = CppLinq::From(src);
+
+	EXPECT_EQ(std::make_pair(1, 9), rng.MinMax());
+	EXPECT_EQ(std::make_pair(9, 1), rng.MinMax([](int a) { return -a; }));
+	EXPECT_EQ(std::make_pair(1, 9), rng.Where([](int) { return true; }).MinMax());
+	EXPECT_EQ(std::make_pair(5, 5), CppLinq::From(std::vector<int>{ 5 }).MinMax());
+	EXPECT_EQ(std::make_pair(0, 9), CppLinq::Range(0, 10, 1).MinMax());
+}
+
+TEST(MinMax, Ties)
+{
+	std::list<std::pair<int, char>> src = { { 2, 'a' }, { 1, 'b' }, { 3, 'c' }, { 1, 'd' }, { 3, 'e' } };
+
+	auto rng = CppLinq::From(src);
+	auto key = [](const std::pair<int, char>& a) { return a.first; };
+
+	EXPECT_EQ('b', rng.MinBy(key).second);
+	EXPECT_EQ('c', rng.MaxBy(key).second);
+	EXPECT_EQ('b', rng.MinMax(key).first.second);
+	EXPECT_EQ('e', rng.MinMax(key).second.second);
+}
+
+TEST(MinMax, KeyComputedOncePerObject)
+{
+	std::vector<std::string> src = { "ccc", "a", "bbbb", "dd" };
+
+	int calls = 0;
+	auto length = [&](const std::string& a) { ++calls; return a.size(); };
+
+	EXPECT_EQ("bbbb", CppLinq::From(src).MaxBy(length));
+	EXPECT_EQ(4, calls);
+
+	calls = 0;
+	EXPECT_EQ("a", CppLinq::From(src).MinBy(length));
+	EXPECT_EQ(4, calls);
+
+	calls = 0;
+	auto extrema = CppLinq::From(src).MinMax(length);
+	EXPECT_EQ("a", extrema.first);
+	EXPECT_EQ("bbbb", extrema.second);
+	EXPECT_EQ(4, calls);
+}
+
+TEST(MinMax, Empty)
+{
+	std::vector<int> src;
+
+	EXPECT_THROW(CppLinq::From(src).MinMax(), CppLinq::EnumeratorEndException);
+	EXPECT_THROW(CppLinq::From(src).Where([](int) { return true; }).MinMax(), CppLinq::EnumeratorEndException);
+	EXPECT_THROW(CppLinq::From(src).MinBy([](int a) { return a; }), CppLinq::EnumeratorEndException);
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <future>
+#include <unordered_map>
+#include <unordered_set>
+
+TEST(Partition, CoversEveryObjectOnce)
+{
+	std::unordered_set<int> src;
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		src.insert(i);
+	}
+
+	auto parts = CppLinq::From(src).Partition(7);
+
+	EXPECT_EQ(7u, parts.size());
+
+	std::vector<int> objects;
+
+	for (const auto& part : parts)
+	{
+		part.Foreach([&](int a) { objects.push_back(a); });
+	}
+
+	std::sort(objects.begin(), objects.end());
+
+	EXPECT_EQ(CppLinq::Range(0, 10000, 1).ToVector(), objects);
+}
+
+TEST(Partition, ParallelAggregate)
+{
+	std::unordered_map<int, long long> src;
+
+	for (int i = 0; i < 100000; ++i)
+	{
+		src.emplace(i, i * 3LL);
+	}
+
+	auto parts = CppLinq::From(src).Partition(4);
+	std::vector<std::future<long long>> sums;
+
+	for (const auto& part : parts)
+	{
+		sums.push_back(std::async(std::launch::async, [part]()
+		{
+			return part.Where([](const std::pair<int, long long>& a) { return a.first % 2 == 0; })
+				.Sum([](const std::pair<int, long long>& a) { return a.second; });
+		}));
+	}
+
+	long long total = 0;
+
+	for (auto& sum : sums)
+	{
+		total += sum.get();
+	}
+
+	EXPECT_EQ(3LL * 2 * (49999LL * 50000 / 2), total);
+}
+
+TEST(Partition, SmallContainers)
+{
+	std::unordered_set<int> empty;
+	std::unordered_set<int> src = { 1, 2, 3 };
+
+	auto emptyParts = CppLinq::From(empty).Partition(8);
+	auto parts = CppLinq::From(src).Partition(1000000);
+
+	EXPECT_LE(1u, emptyParts.size());
+	EXPECT_EQ(0u, emptyParts.front().Count());
+	EXPECT_EQ(src.bucket_count(), parts.size());
+	EXPECT_EQ(6, CppLinq::From(src).Partition(2)[0].Concat(CppLinq::From(src).Partition(2)[1]).Sum());
+	EXPECT_NE(std::string::npos, parts.front().Explain().ToString().find("Source: buckets [0, 1)"));
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#define CPP_LINQ_PROFILING
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <sstream>
+
+TEST(Profiling, StageCounts)
+{
+	int src[] = { 5, 3, 8, 1, 9, 2, 7 };
+	int ans[] = { 1, 4, 9, 49, 64, 81 };
+
+	CppLinq::QueryProfile profile;
+	auto dst = CppLinq::From(src).WithProfiling(profile)
+		.Where([](int a) { return a != 5; })
+		.OrderBy()
+		.Select([](int a) { return a * a; });
+
+	IsEqualArray(dst, ans);
+
+	auto stages = profile.Stages();
+
+	ASSERT_EQ(4u, stages.size());
+	EXPECT_EQ("Source", stages[0].name);
+	EXPECT_EQ("Where", stages[1].name);
+	EXPECT_EQ("OrderBy", stages[2].name);
+	EXPECT_EQ("Select", stages[3].name);
+	EXPECT_EQ(7u, stages[1].objectsIn);
+	EXPECT_EQ(6u, stages[1].objectsOut);
+	EXPECT_EQ(6u, stages[2].peakBuffered);
+	EXPECT_EQ(6u, stages[3].objectsOut);
+	EXPECT_GE(stages[3].time, stages[2].time);
+}
+
+TEST(Profiling, Terminals)
+{
+	std::vector<int> src = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+	CppLinq::QueryProfile profile;
+	auto dst = CppLinq::From(src).WithProfiling(profile).Where([](int a) { return a % 2 == 0; }).Select([](int a) { return a + 1; });
+
+	EXPECT_EQ(24, dst.Sum());
+	EXPECT_EQ(4, dst.Count());
+
+	auto stages = profile.Stages();
+
+	EXPECT_EQ(16u, stages[0].objectsOut);
+	EXPECT_EQ(8u, stages[2].objectsOut);
+
+	std::ostringstream stream;
+	stream << profile;
+	EXPECT_NE(std::string::npos, stream.str().find("Where: 16 in, 8 out"));
+
+	profile.Reset();
+	EXPECT_EQ(0u, profile.Stages()[1].objectsOut);
+}
+
+TEST(Profiling, SampledTiming)
+{
+	std::vector<int> src(1000, 1);
+
+	CppLinq::QueryProfile profile;
+	auto dst = CppLinq::From(src).WithProfiling(profile).Where([](int a) { return a > 0; });
+
+	EXPECT_EQ(1000, dst.Count());
+	EXPECT_EQ(1000u, dst.ToVector().size());
+
+	auto stages = profile.Stages();
+
+	EXPECT_EQ(2000u, stages[1].objectsOut);
+	EXPECT_GE(stages[1].time, stages[1].selfTime);
+}
+
+TEST(Profiling, NotRewritten)
+{
+	int src[] = { 1, 2, 3 };
+
+	CppLinq::QueryProfile profile;
+	auto plan = CppLinq::From(src).WithProfiling(profile).Where([](int a) { return a > 1; }).Where([](int a) { return a < 3; }).Explain();
+
+	EXPECT_EQ("Where", plan.name);
+	EXPECT_EQ("profiled, so it is not fused with neighbouring stages", plan.notes.back());
+	EXPECT_EQ("Where", plan.inputs[0].name);
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(QueryRewrite, WhereWhere)
+{
+	int src[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+	int ans[] = { 6, 12 };
+
+	bool (*even)(int) = [](int a) { return a % 2 == 0; };
+	bool (*triple)(int) = [](int a) { return a % 3 == 0; };
+
+	auto rng = CppLinq::From(src);
+	auto dst = rng.Where(even).Where(triple);
+
+	using FusedType = CppLinq::WhereEnumerator<decltype(rng.m_enumerator), CppLinq::AndPredicate<bool(*)(int), bool(*)(int)>>;
+	EXPECT_TRUE((std::is_same<decltype(dst.m_enumerator), FusedType>::value));
+
+	IsEqualArray(dst, ans);
+}
+
+TEST(QueryRewrite, SelectSelect)
+{
+	int src[] = { 1, 2, 3 };
+	double ans[] = { 1.5, 2.5, 3.5 };
+
+	auto dst = CppLinq::From(src).Select([](int a) { return a * 2; }).Select([](int a) { return (a + 1) / 2.0; });
+
+	IsEqualArray(dst, ans);
+}
+
+TEST(QueryRewrite, SelectSelectByReference)
+{
+	int src[] = { 1, 2, 3 };
+	int ans[] = { 3, 5, 7 };
+
+	auto dst = CppLinq::From(src).Select([](int a) { return a * 2; }).Select([](int& a) { return ++a; });
+
+	IsEqualArray(dst, ans);
+}
+
+TEST(QueryRewrite, SelectCount)
+{
+	int src[] = { 1, 2, 3, 4, 5 };
+	int calls = 0;
+
+	auto rng = CppLinq::From(src).Where([](int a) { return a > 1; }).Select([&](int a) { calls++; return a * 2; });
+
+	EXPECT_EQ(4, rng.Count());
+	EXPECT_EQ(0, calls);
+	EXPECT_EQ(2, rng.Count([](int a) { return a > 6; }));
+	EXPECT_EQ(4, calls);
+}
+
+TEST(QueryRewrite, SelectAny)
+{
+	int src[] = { 1, 2, 3, 4, 5 };
+	int calls = 0;
+
+	auto rng = CppLinq::From(src).Select([&](int a) { calls++; return a > 2; });
+
+	EXPECT_TRUE(rng.Any());
+	EXPECT_EQ(3, calls);
+	EXPECT_FALSE(CppLinq::From(src).Select([](int a) { return a > 5; }).Any());
+}
+
+TEST(QueryRewrite, OrderByWhere)
+{
+	int src[] = { 4, 5, 3, 1, 4, 2, 1, 4, 6 };
+	int ans[] = { 6, 5, 4, 4, 4 };
+	int calls = 0;
+
+	auto dst = CppLinq::From(src).OrderBy([&](int a) { calls++; return -a; }).Where([](int a) { return a > 3; });
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(5, calls);
+}
+
+TEST(QueryRewrite, ReverseWhere)
+{
+	int src[] = { 1, 2, 3, 4, 5, 6 };
+	int ans[] = { 6, 4, 2 };
+
+	auto rng = CppLinq::From(src).Reverse();
+	auto dst = rng.Where([](int a) { return a % 2 == 0; });
+
+	IsEqualArray(dst, ans);
+
+	rng.NextObject();
+	int rest[] = { 4, 2 };
+	IsEqualArray(rng.Where([](int a) { return a % 2 == 0; }), rest);
+}
+
+TEST(QueryRewrite, OrderByFirst)
+{
+	std::vector<std::pair<int, char>> src = { { 3, 'a' }, { 1, 'b' }, { 2, 'c' }, { 1, 'd' } };
+	int calls = 0;
+
+	auto rng = CppLinq::From(src).OrderBy([&](std::pair<int, char> a) { calls++; return a.first; });
+
+	EXPECT_EQ('b', rng.First().second);
+	EXPECT_EQ(4, calls);
+	EXPECT_EQ('c', rng.First([](std::pair<int, char> a) { return a.second != 'b' && a.second != 'd'; }).second);
+	EXPECT_THROW(CppLinq::From(src).Where([](std::pair<int, char>) { return false; }).OrderBy().First(), CppLinq::EnumeratorEndException);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <cstdint>
+#include <limits>
+
+TEST(Range, IntStep)
+{
+	int ans[] = { 0, 3, 6, 9 };
+
+	auto dst = CppLinq::Range(0, 10, 3);
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(4, dst.Count());
+	EXPECT_EQ(18, dst.Sum());
+	EXPECT_EQ(4, dst.Average());
+	EXPECT_EQ(0, dst.Min());
+	EXPECT_EQ(9, dst.Max());
+	EXPECT_EQ(6, dst.ElementAt(2));
+	EXPECT_THROW(dst.ElementAt(4), CppLinq::EnumeratorEndException);
+	EXPECT_TRUE(dst.Contains(9));
+	EXPECT_FALSE(dst.Contains(10));
+	EXPECT_FALSE(dst.Contains(-3));
+	EXPECT_EQ((std::vector<int>{ 0, 3, 6, 9 }), dst.ToVector());
+}
+
+TEST(Range, SkipTake)
+{
+	int ans[] = { 30, 40, 50 };
+
+	auto dst = CppLinq::Range(0, 100, 10).Skip(3).Take(3);
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(3, dst.Count());
+	EXPECT_EQ(120, dst.Sum());
+	EXPECT_EQ(0, CppLinq::Range(0, 100, 10).Skip(20).Count());
+	EXPECT_EQ(0, CppLinq::Range(5, 0, 1).Count());
+}
+
+TEST(Range, Double)
+{
+	double ans[] = { 0.0, 0.25, 0.5, 0.75 };
+
+	auto dst = CppLinq::Range(0.0, 1.0, 0.25);
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(4, dst.Count());
+	EXPECT_DOUBLE_EQ(1.5, dst.Sum());
+	EXPECT_TRUE(dst.Contains(0.5));
+	EXPECT_FALSE(dst.Contains(0.6));
+	EXPECT_DOUBLE_EQ(0.75, dst.Where([](double a) { return a > 0.5; }).Sum());
+}
+
+TEST(Range, FullWidth)
+{
+	const std::int64_t min = std::numeric_limits<std::int64_t>::min();
+	const std::int64_t max = std::numeric_limits<std::int64_t>::max();
+	auto rng = CppLinq::Range(min, max, std::int64_t(1));
+
+	EXPECT_EQ(std::numeric_limits<std::size_t>::max(), rng.Count());
+	EXPECT_EQ(max - 1, rng.Max());
+	EXPECT_EQ(min + 1, rng.Skip(1).First());
+	EXPECT_EQ(-1, rng.Average());
+	EXPECT_TRUE(rng.Contains(max - 1));
+	EXPECT_FALSE(rng.Contains(max));
+
+	auto big = CppLinq::Range(std::uint64_t(0), std::numeric_limits<std::uint64_t>::max(), std::uint64_t(1) << 62);
+
+	EXPECT_EQ(4u, big.Count());
+	EXPECT_EQ(std::uint64_t(3) << 62, big.Max());
+	EXPECT_EQ(3u, CppLinq::Range(std::int8_t(-100), std::int8_t(120), std::int8_t(100)).Count());
+
+	std::vector<std::int64_t> quarters = { min, min + (std::int64_t(1) << 62), 0, std::int64_t(1) << 62 };
+
+	EXPECT_EQ(quarters, CppLinq::Range(min, max, std::int64_t(1) << 62).ToVector());
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(Scan, RunningSum)
+{
+	int src[] = { 1, 2, 3, 4, 5 };
+	int ans[] = { 11, 13, 16, 20, 25 };
+
+	auto dst = CppLinq::From(src).Scan(10, [](int acc, int a) { return acc + a; });
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(5u, dst.m_enumerator.Size());
+	EXPECT_EQ(25, dst.Max());
+}
+
+TEST(Scan, ParallelPrefixSum)
+{
+	std::vector<long long> src(1000003);
+
+	for (size_t i = 0; i < src.size(); ++i)
+	{
+		src[i] = static_cast<long long>(i % 7) - 3;
+	}
+
+	auto add = [](long long acc, long long a) { return acc + a; };
+	std::vector<long long> ans = CppLinq::From(src).Scan(5LL, add).ToVector();
+
+	EXPECT_EQ(ans, CppLinq::From(src).ParallelScan(5LL, add, 4));
+	EXPECT_EQ(ans, CppLinq::From(src).Where([](long long) { return true; }).ParallelScan(5LL, add, 3));
+	EXPECT_EQ((std::vector<long long>{ 1, 3, 6 }), CppLinq::Range(1LL, 4LL, 1LL).ParallelScan(0LL, add));
+}
+
+TEST(Scan, ParallelScanWithCombine)
+{
+	std::vector<int> src(100000, 7);
+
+	auto count = [](long long acc, int) { return acc + 1; };
+	auto add = [](long long a, long long b) { return a + b; };
+	std::vector<long long> ans = CppLinq::From(src).Scan(0LL, count).ToVector();
+	std::vector<long long> dst = CppLinq::From(src).ParallelScan(0LL, count, add, 0LL, 4);
+
+	EXPECT_EQ(100000LL, ans.back());
+	EXPECT_EQ(ans, dst);
+}
\ No newline at end of file
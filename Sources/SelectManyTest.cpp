@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <thread>
+
+TEST(SelectMany, NestedVectors)
+{
+	std::vector<std::vector<int>> src = { { 1, 2 }, { }, { 3 }, { 4, 5, 6 } };
+	int ans[] = { 1, 2, 3, 4, 5, 6 };
+
+	int rest[] = { 2, 3, 4, 5, 6 };
+
+	auto dst = CppLinq::From(src).SelectMany([](const std::vector<int>& a) { return CppLinq::From(a); });
+
+	IsEqualArray(dst, ans);
+
+	dst.NextObject();
+	IsEqualArray(dst, rest);
+}
+
+TEST(SelectMany, RangesAndCopy)
+{
+	int src[] = { 1, 2, 3 };
+	int ans[] = { 0, 0, 1, 0, 1, 2 };
+	int rest[] = { 1, 0, 1, 2 };
+
+	auto dst = CppLinq::From(src).SelectMany([](int a) { return CppLinq::Range(0, a, 1); });
+
+	IsEqualArray(dst, ans);
+
+	dst.NextObject();
+	dst.NextObject();
+	IsEqualArray(dst, rest);
+}
+
+TEST(SelectMany, CopyKeepsPosition)
+{
+	std::vector<std::vector<int>> src = { { 1, 2, 3 }, { 4, 5 } };
+	int ans[] = { 3, 4, 5 };
+	static int calls = 0;
+
+	auto dst = CppLinq::From(src).SelectMany(+[](const std::vector<int>& a) { calls++; return CppLinq::From(a); });
+	auto copy = dst;
+
+	dst.NextObject();
+
+	{
+		auto temp = dst;
+		temp.NextObject();
+		copy = temp;
+	}
+
+	EXPECT_EQ(1, calls);
+	IsEqualArray(copy, ans);
+	EXPECT_EQ(2, dst.NextObject());
+}
+
+TEST(SelectMany, CopiesOnOtherThreads)
+{
+	std::vector<std::vector<int>> src(1000, std::vector<int>{ 1, 2, 3 });
+
+	auto dst = CppLinq::From(src).SelectMany([](const std::vector<int>& a) { return CppLinq::From(a); });
+	dst.NextObject();
+	auto copy = dst;
+
+	int copySum = 0;
+	std::thread thread([&]() { copySum = copy.Sum(); });
+	int sum = dst.Sum();
+	thread.join();
+
+	EXPECT_EQ(5999, sum);
+	EXPECT_EQ(5999, copySum);
+}
\ No newline at end of file
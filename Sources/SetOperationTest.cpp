@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <list>
+#include <set>
+
+TEST(SetOperation, Union)
+{
+	std::vector<int> src1 = { 5, 3, 9, 3, 7 };
+	std::list<int> src2 = { 8, 3, 5, 1, 8 };
+	int ans[] = { 5, 3, 9, 7, 8, 1 };
+
+	auto dst = CppLinq::From(src1).Union(CppLinq::From(src2));
+
+	IsEqualArray(dst, ans);
+}
+
+TEST(SetOperation, Intersect)
+{
+	std::vector<int> src1 = { 5, 3, 9, 3, 7, 1 };
+	std::list<int> src2 = { 8, 3, 5, 1, 8 };
+	std::vector<int> small = { 1, 5, 5 };
+	int ans[] = { 5, 3, 1 };
+	int ansSmall[] = { 1, 5 };
+
+	IsEqualArray(CppLinq::From(src1).Intersect(CppLinq::From(src2)), ans);
+	IsEqualArray(CppLinq::From(small).Intersect(CppLinq::From(src1)), ansSmall);
+}
+
+TEST(SetOperation, Except)
+{
+	std::vector<int> src1 = { 5, 3, 9, 3, 7, 1, 9 };
+	std::list<int> src2 = { 8, 3, 5, 8 };
+	std::vector<int> small = { 9, 2, 2, 5 };
+	int ans[] = { 9, 7, 1 };
+	int ansSmall[] = { 2 };
+
+	IsEqualArray(CppLinq::From(src1).Except(CppLinq::From(src2)), ans);
+	IsEqualArray(CppLinq::From(small).Except(CppLinq::From(src1)), ansSmall);
+}
+
+TEST(SetOperation, SmallerFirstSinglePass)
+{
+	std::vector<int> src1 = { 9, 2, 2, 5, 4 };
+	std::vector<int> src2 = { 5, 3, 9, 3, 7, 1, 9, 8 };
+	int ansIntersect[] = { 9, 5 };
+	int calls = 0;
+
+	auto rng = CppLinq::From(src1).Select([&](int a) { calls++; return a; });
+
+	IsEqualArray(rng.Intersect(CppLinq::From(src2)), ansIntersect);
+	EXPECT_EQ(5, calls);
+
+	calls = 0;
+	auto dst = rng.Except(CppLinq::From(src2));
+
+	EXPECT_EQ(2, dst.NextObject());
+	EXPECT_EQ(5, calls);
+	EXPECT_EQ(2u, dst.m_enumerator.Buffered());
+	EXPECT_EQ(4, dst.NextObject());
+	EXPECT_THROW(dst.NextObject(), CppLinq::EnumeratorEndException);
+	EXPECT_EQ(5, calls);
+}
+
+TEST(SetOperation, NotHashable)
+{
+	std::vector<std::pair<int, int>> src1 = { { 1, 2 }, { 3, 4 }, { 1, 2 } };
+	std::vector<std::pair<int, int>> src2 = { { 3, 4 }, { 5, 6 } };
+
+	EXPECT_EQ(3u, CppLinq::From(src1).Union(CppLinq::From(src2)).Count());
+	EXPECT_EQ(1u, CppLinq::From(src1).Intersect(CppLinq::From(src2)).Count());
+	EXPECT_EQ(1u, CppLinq::From(src1).Except(CppLinq::From(src2)).Count());
+}
+
+TEST(SetOperation, SortedMerge)
+{
+	std::set<int> src1 = { 1, 3, 5, 7, 9 };
+	std::multiset<int> src2 = { 3, 3, 4, 9, 9, 11 };
+	int ansUnion[] = { 1, 3, 4, 5, 7, 9, 11 };
+	int ansIntersect[] = { 3, 9 };
+	int ansExcept[] = { 1, 5, 7 };
+	int ansExceptReversed[] = { 4, 11 };
+
+	auto rng1 = CppLinq::From(src1);
+	auto rng2 = CppLinq::From(src2);
+
+	IsEqualArray(rng1.Union(rng2), ansUnion);
+	IsEqualArray(rng1.Intersect(rng2), ansIntersect);
+	IsEqualArray(rng1.Except(rng2), ansExcept);
+	IsEqualArray(rng2.Except(rng1), ansExceptReversed);
+
+	EXPECT_TRUE((CppLinq::IsSortedEnumerator<decltype(rng1.Union(rng2).m_enumerator)>::value));
+	EXPECT_NE(std::string::npos, rng1.Intersect(rng2).Explain().ToString().find("linear merge"));
+}
+
+TEST(SetOperation, SortedRangeAndOrderBy)
+{
+	std::vector<int> src = { 12, 4, 8, 4, 2 };
+	int ans[] = { 2, 4, 8, 12 };
+	int ansExcept[] = { 0, 1, 3, 5 };
+
+	auto sorted = CppLinq::From(src).OrderBy();
+
+	IsEqualArray(sorted.Intersect(CppLinq::Range(0, 20, 2)), ans);
+	IsEqualArray(CppLinq::Range(0, 6, 1).Except(sorted), ansExcept);
+	EXPECT_NE(std::string::npos, sorted.Union(CppLinq::Range(0, 3, 1)).Explain().ToString().find("linear merge"));
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <list>
+#include <set>
+
+TEST(Sorted, Propagation)
+{
+	std::set<int> src = { 1, 2, 3, 4 };
+
+	auto rng = CppLinq::From(src);
+	auto even = [](int a) { return a % 2 == 0; };
+	auto negate = [](int a) { return -a; };
+
+	EXPECT_TRUE((CppLinq::IsSortedEnumerator<decltype(rng.Where(even).Skip(1).Take(2).Distinct().m_enumerator)>::value));
+	EXPECT_TRUE((CppLinq::IsSortedEnumerator<decltype(rng.Memoize().m_enumerator)>::value));
+	EXPECT_FALSE((CppLinq::IsSortedEnumerator<decltype(rng.Select(negate).m_enumerator)>::value));
+	EXPECT_FALSE((CppLinq::IsSortedEnumerator<decltype(rng.Reverse().m_enumerator)>::value));
+}
+
+TEST(Sorted, AsSortedBinarySearch)
+{
+	std::vector<int> src = { 1, 3, 3, 3, 5, 8, 13 };
+	int ansLower[] = { 5, 8, 13 };
+	int ansEqual[] = { 3, 3, 3 };
+	int ansDistinct[] = { 1, 3, 5, 8, 13 };
+
+	auto rng = CppLinq::From(src).AsSorted();
+
+	IsEqualArray(rng.LowerBound(4), ansLower);
+	IsEqualArray(rng.EqualRange(3), ansEqual);
+	IsEqualArray(rng.Distinct(), ansDistinct);
+	EXPECT_EQ(3u, rng.EqualRange(3).Count());
+	EXPECT_EQ(0u, rng.EqualRange(4).Count());
+	EXPECT_EQ(0u, rng.LowerBound(20).Count());
+	EXPECT_TRUE(rng.Contains(8));
+	EXPECT_FALSE(rng.Contains(7));
+	EXPECT_EQ(1, rng.Min());
+	EXPECT_EQ(13, rng.Max());
+	EXPECT_EQ(std::make_pair(1, 13), rng.MinMax());
+	EXPECT_NE(std::string::npos, rng.EqualRange(3).Explain().ToString().find("binary search"));
+}
+
+TEST(Sorted, ForwardSources)
+{
+	std::list<int> list = { 2, 2, 4, 6, 6, 9 };
+	std::multiset<int> src(list.begin(), list.end());
+	int ansLower[] = { 6, 6, 9 };
+	int ansEqual[] = { 6, 6 };
+	int ansDistinct[] = { 2, 4, 6, 9 };
+
+	auto rng = CppLinq::From(src);
+	auto listRng = CppLinq::From(list).AsSorted();
+
+	IsEqualArray(rng.LowerBound(5), ansLower);
+	IsEqualArray(listRng.EqualRange(6), ansEqual);
+	IsEqualArray(rng.Where([](int a) { return a > 0; }).Distinct(), ansDistinct);
+	EXPECT_TRUE(rng.Contains(4));
+	EXPECT_FALSE(listRng.Contains(5));
+	EXPECT_EQ(2, rng.Min());
+	EXPECT_EQ(9, listRng.Max());
+	EXPECT_THROW(CppLinq::From(std::set<int>()).Max(), CppLinq::EnumeratorEndException);
+}
+
+TEST(Sorted, RedundantOrderBy)
+{
+	std::set<int> src = { 5, 1, 3 };
+	std::vector<int> unsorted = { 5, 1, 3 };
+	int ans[] = { 1, 3, 5 };
+
+	auto rng = CppLinq::From(src).OrderBy();
+	auto sorted = CppLinq::From(unsorted).OrderBy().OrderBy();
+
+	IsEqualArray(rng, ans);
+	IsEqualArray(sorted, ans);
+	EXPECT_TRUE((std::is_same<decltype(CppLinq::From(src)), decltype(rng)>::value));
+	EXPECT_TRUE((std::is_same<decltype(CppLinq::From(unsorted).OrderBy()), decltype(sorted)>::value));
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(ToArray, Vector2Array)
+{
+	std::vector<int> src = { 1, 2, 3, 4 };
+
+	auto full = CppLinq::From(src).ToArray<4>();
+	auto part = CppLinq::From(src).Take(2).ToArray<2>();
+
+	EXPECT_EQ((std::array<int, 4>{ 1, 2, 3, 4 }), full);
+	EXPECT_EQ((std::array<int, 2>{ 1, 2 }), part);
+	EXPECT_THROW(CppLinq::From(src).ToArray<2>(), std::length_error);
+	EXPECT_THROW(CppLinq::From(src).ToArray<6>(), std::length_error);
+	EXPECT_THROW(CppLinq::StaticRange<8>(0, 4, 1).ToArray<3>(), std::length_error);
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <string>
+
+TEST(ToDictionary, KeyAndValue)
+{
+	std::vector<std::string> src = { "one", "three", "five" };
+
+	auto dst = CppLinq::From(src).ToDictionary([](const std::string& a) { return a.size(); }, [](const std::string& a) { return a[0]; });
+
+	EXPECT_EQ(3u, dst.size());
+	EXPECT_EQ('o', dst.at(3));
+	EXPECT_EQ('t', dst.at(5));
+	EXPECT_EQ('f', dst.at(4));
+}
+
+TEST(ToDictionary, KeyOnly)
+{
+	std::vector<std::pair<int, int>> src = { { 1, 10 }, { 2, 20 } };
+
+	auto dst = CppLinq::From(src).Where([](const std::pair<int, int>&) { return true; }).ToDictionary([](const std::pair<int, int>& a) { return a.first; });
+
+	EXPECT_EQ(2u, dst.size());
+	EXPECT_EQ(20, dst.at(2).second);
+}
+
+TEST(ToDictionary, DuplicateKey)
+{
+	std::vector<int> src = { 1, 2, 3, 4 };
+
+	EXPECT_THROW(CppLinq::From(src).ToDictionary([](int a) { return a % 2; }), std::invalid_argument);
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <set>
+
+TEST(ToFlatSet, Vector2FlatSet)
+{
+	std::vector<int> src = { 3, 1, 1, 2, 3, 2 };
+
+	auto dst = CppLinq::From(src).ToFlatSet();
+
+	EXPECT_EQ((std::vector<int>{ 1, 2, 3 }), dst);
+	EXPECT_EQ((std::set<int>{ 1, 2, 3 }), CppLinq::From(src).ToSet());
+}
+
+TEST(ToFlatSet, SortedSource)
+{
+	std::multiset<int> src = { 4, 4, 1, 9, 1 };
+
+	EXPECT_EQ((std::vector<int>{ 1, 4, 9 }), CppLinq::From(src).ToFlatSet());
+	EXPECT_EQ((std::vector<int>{ 0, 2, 4 }), CppLinq::Range(0, 6, 2).ToFlatSet());
+	EXPECT_TRUE(CppLinq::From(std::vector<int>()).ToFlatSet().empty());
+}
\ No newline at end of file
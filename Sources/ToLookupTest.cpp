@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+#include <list>
+
+TEST(ToLookup, GroupsInOrder)
+{
+	std::list<int> src = { 5, 2, 8, 3, 6, 1, 4 };
+	int ansEven[] = { 2, 8, 6, 4 };
+	int ansOdd[] = { 5, 3, 1 };
+	int ansKeys[] = { 1, 0 };
+
+	auto dst = CppLinq::From(src).ToLookup([](int a) { return a % 2; });
+
+	EXPECT_EQ(2u, dst.Size());
+	IsEqualArray(CppLinq::From(dst.Keys()), ansKeys);
+	IsEqualArray(CppLinq::From(dst[0]), ansEven);
+	IsEqualArray(CppLinq::From(dst[1]), ansOdd);
+	EXPECT_EQ(dst[1].Data() + 3, dst[0].Data());
+}
+
+TEST(ToLookup, MissingKey)
+{
+	std::vector<std::pair<int, int>> src = { { 1, 2 }, { 1, 3 } };
+
+	auto dst = CppLinq::From(src).ToLookup([](const std::pair<int, int>& a) { return a; });
+
+	EXPECT_TRUE(dst.Contains(std::make_pair(1, 2)));
+	EXPECT_FALSE(dst.Contains(std::make_pair(2, 2)));
+	EXPECT_EQ(0u, dst[std::make_pair(2, 2)].Size());
+	EXPECT_EQ(1u, dst[std::make_pair(1, 3)].Size());
+}
\ No newline at end of file
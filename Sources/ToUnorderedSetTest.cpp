@@ -0,0 +1,18 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(ToUnorderedSet, Vector2UnorderedSet)
+{
+	std::vector<int> src = { 1, 1, 2, 3, 2 };
+
+	auto rng = CppLinq::From(src);
+	auto dst = rng.ToUnorderedSet();
+
+	EXPECT_EQ(3U, dst.size());
+	EXPECT_NE(dst.end(), dst.find(1));
+	EXPECT_NE(dst.end(), dst.find(2));
+	EXPECT_NE(dst.end(), dst.find(3));
+	EXPECT_LE(5U, dst.bucket_count());
+}
\ No newline at end of file
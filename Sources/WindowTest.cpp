@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(Window, SumAverage)
+{
+	int src[] = { 1, 2, 3, 4, 5, 6 };
+	int sum[] = { 6, 9, 12, 15 };
+	double average[] = { 1.5, 2.5, 3.5, 4.5, 5.5 };
+
+	auto rng = CppLinq::From(src);
+
+	IsEqualArray(rng.Window<CppLinq::WindowSum>(3), sum);
+	IsEqualArray(rng.Cast<double>().Window<CppLinq::WindowAverage>(2), average);
+	EXPECT_EQ(4u, rng.Window<CppLinq::WindowSum>(3).m_enumerator.Size());
+	EXPECT_EQ(0, rng.Window<CppLinq::WindowSum>(7).Count());
+}
+
+TEST(Window, MinMax)
+{
+	std::vector<int> src = { 5, 1, 4, 4, 2, 8, 3, 3, 9, 0 };
+	const size_t size = 3;
+
+	std::vector<int> minAns;
+	std::vector<int> maxAns;
+
+	for (size_t i = 0; i + size <= src.size(); ++i)
+	{
+		minAns.push_back(*std::min_element(src.begin() + i, src.begin() + i + size));
+		maxAns.push_back(*std::max_element(src.begin() + i, src.begin() + i + size));
+	}
+
+	EXPECT_EQ(minAns, CppLinq::From(src).Window<CppLinq::WindowMin>(size).ToVector());
+	EXPECT_EQ(maxAns, CppLinq::From(src).Window<CppLinq::WindowMax>(size).ToVector());
+	EXPECT_EQ(src, CppLinq::From(src).Window<CppLinq::WindowMax>(1).ToVector());
+}
\ No newline at end of file
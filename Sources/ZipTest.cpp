@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "CppLinq.h"
+#include "TestUtils.h"
+
+TEST(Zip, VectorVector)
+{
+	std::vector<int> src1 = { 1, 2, 3, 4 };
+	std::vector<int> src2 = { 10, 20, 30 };
+	int ans[] = { 11, 22, 33 };
+
+	auto dst = CppLinq::From(src1).Zip(CppLinq::From(src2), [](int a, int b) { return a + b; });
+
+	EXPECT_TRUE(CppLinq::IsContiguousEnumerator<decltype(CppLinq::From(src1).m_enumerator)>::value);
+	EXPECT_EQ(3u, dst.m_enumerator.Size());
+	EXPECT_EQ(66, dst.Sum());
+	IsEqualArray(dst, ans);
+}
+
+TEST(Zip, DotProduct)
+{
+	std::vector<double> src1(1000);
+	std::vector<double> src2(1000);
+
+	for (size_t i = 0; i < src1.size(); ++i)
+	{
+		src1[i] = static_cast<double>(i);
+		src2[i] = 2.0;
+	}
+
+	auto dst = CppLinq::From(src1).Zip(CppLinq::From(src2), [](double a, double b) { return a * b; });
+
+	EXPECT_DOUBLE_EQ(999000.0, dst.Sum());
+	EXPECT_EQ(1000, dst.Count());
+}
+
+TEST(Zip, ThreeSources)
+{
+	int src1[] = { 1, 2, 3 };
+	std::list<int> src2 = { 4, 5, 6 };
+	int ans[] = { 4, 10, 18 };
+
+	auto dst = CppLinq::Zip([](int a, int b, int c) { return a * b * c; }, CppLinq::From(src1), CppLinq::From(src2), CppLinq::Repeat(1, 5));
+
+	IsEqualArray(dst, ans);
+	EXPECT_EQ(CppLinq::UnknownSize, dst.m_enumerator.Size());
+}
\ No newline at end of file